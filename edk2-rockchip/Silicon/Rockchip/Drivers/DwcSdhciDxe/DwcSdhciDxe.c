@@ -10,22 +10,270 @@
  *
  **/
 
+#include <Library/BaseLib.h>
+#include <Library/BaseMemoryLib.h>
 #include <Library/DebugLib.h>
 #include <Library/IoLib.h>
+#include <Library/MemoryAllocationLib.h>
 #include <Library/NonDiscoverableDeviceRegistrationLib.h>
 #include <Library/UefiBootServicesTableLib.h>
 #include <Library/DwcSdhciPlatformLib.h>
 
 #include <Protocol/NonDiscoverableDevice.h>
+#include <Protocol/PciIo.h>
 #include <Protocol/SdMmcOverride.h>
 
 #include "DwcSdhciDxe.h"
 
 #define EMMC_FORCE_HIGH_SPEED  FixedPcdGetBool(PcdDwcSdhciForceHighSpeed)
 #define EMMC_DISABLE_HS400     FixedPcdGetBool(PcdDwcSdhciDisableHs400)
+#define EMMC_DISABLE_ADMA2     FixedPcdGetBool(PcdDwcSdhciDisableAdma2)
+
+//
+// A single ADMA2 descriptor must not cross this boundary.
+//
+#define EMMC_ADMA_BOUNDARY  SIZE_128MB
 
 STATIC EFI_HANDLE  mSdMmcControllerHandle;
 
+//
+// A data buffer that crossed an ADMA boundary, mapped through a bounce
+// buffer instead.
+//
+typedef struct {
+  LIST_ENTRY                       Link;
+  EFI_PCI_IO_PROTOCOL_OPERATION    Operation;
+  VOID                             *HostAddress;
+  VOID                             *Buffer;
+  UINTN                            NumberOfBytes;
+  UINTN                            Pages;
+  VOID                             *Mapping;
+} EMMC_BOUNCE_MAPPING;
+
+STATIC LIST_ENTRY                 mBounceMappings = INITIALIZE_LIST_HEAD_VARIABLE (mBounceMappings);
+STATIC EFI_PCI_IO_PROTOCOL_MAP    mPciIoMap;
+STATIC EFI_PCI_IO_PROTOCOL_UNMAP  mPciIoUnmap;
+STATIC VOID                       *mPciIoRegistration;
+
+/**
+  Check whether a DMA range crosses an ADMA boundary.
+
+  @param[in]  Address   The device address of the range.
+  @param[in]  Length    The length of the range in bytes.
+
+  @retval TRUE    The range crosses an ADMA boundary.
+  @retval FALSE   The range fits between two boundaries.
+
+**/
+STATIC
+BOOLEAN
+EmmcCrossesAdmaBoundary (
+  IN EFI_PHYSICAL_ADDRESS  Address,
+  IN UINTN                 Length
+  )
+{
+  return (Length > 0) &&
+         ((Address & ~(EMMC_ADMA_BOUNDARY - 1)) !=
+          ((Address + Length - 1) & ~(EMMC_ADMA_BOUNDARY - 1)));
+}
+
+/**
+  PCI I/O Map() wrapper for the SDHCI controller.
+
+  SdMmcPciHcDxe builds the ADMA2 descriptor tables and only splits them
+  by length, so a descriptor crosses a 128 MB boundary whenever the data
+  buffer does. Such buffers are rare and are mapped through a bounce
+  buffer that can't cross one instead.
+
+  See EFI_PCI_IO_PROTOCOL.Map() for the parameters.
+
+**/
+STATIC
+EFI_STATUS
+EFIAPI
+EmmcPciIoMap (
+  IN     EFI_PCI_IO_PROTOCOL            *This,
+  IN     EFI_PCI_IO_PROTOCOL_OPERATION  Operation,
+  IN     VOID                           *HostAddress,
+  IN OUT UINTN                          *NumberOfBytes,
+  OUT    EFI_PHYSICAL_ADDRESS           *DeviceAddress,
+  OUT    VOID                           **Mapping
+  )
+{
+  EFI_STATUS           Status;
+  EMMC_BOUNCE_MAPPING  *Bounce;
+  UINTN                Size;
+  UINTN                Alignment;
+  EFI_TPL              OldTpl;
+
+  Status = mPciIoMap (This, Operation, HostAddress, NumberOfBytes, DeviceAddress, Mapping);
+  if (EFI_ERROR (Status) ||
+      (Operation == EfiPciIoOperationBusMasterCommonBuffer) ||
+      (Operation == EfiPciIoOperationBusMasterCommonBuffer64) ||
+      !EmmcCrossesAdmaBoundary (*DeviceAddress, *NumberOfBytes))
+  {
+    return Status;
+  }
+
+  mPciIoUnmap (This, *Mapping);
+
+  //
+  // A naturally aligned block can't cross a boundary that is a multiple
+  // of its size.
+  //
+  Size      = EFI_PAGES_TO_SIZE (EFI_SIZE_TO_PAGES (*NumberOfBytes));
+  Alignment = (UINTN)GetPowerOfTwo64 (Size);
+  if (Alignment < Size) {
+    Alignment <<= 1;
+  }
+
+  if (Alignment > EMMC_ADMA_BOUNDARY) {
+    DEBUG ((DEBUG_ERROR, "%a: Can't bounce %lu bytes\n", __FUNCTION__, (UINT64)*NumberOfBytes));
+    return EFI_UNSUPPORTED;
+  }
+
+  Bounce = AllocateZeroPool (sizeof (EMMC_BOUNCE_MAPPING));
+  if (Bounce == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  Bounce->Operation     = Operation;
+  Bounce->HostAddress   = HostAddress;
+  Bounce->NumberOfBytes = *NumberOfBytes;
+  Bounce->Pages         = EFI_SIZE_TO_PAGES (Size);
+  Bounce->Buffer        = AllocateAlignedPages (Bounce->Pages, Alignment);
+  if (Bounce->Buffer == NULL) {
+    Status = EFI_OUT_OF_RESOURCES;
+    goto Error;
+  }
+
+  if ((Operation == EfiPciIoOperationBusMasterRead) ||
+      (Operation == EfiPciIoOperationBusMasterRead64))
+  {
+    CopyMem (Bounce->Buffer, HostAddress, Bounce->NumberOfBytes);
+  }
+
+  Status = mPciIoMap (This, Operation, Bounce->Buffer, NumberOfBytes, DeviceAddress, &Bounce->Mapping);
+  if (EFI_ERROR (Status)) {
+    goto Error;
+  }
+
+  //
+  // The PCI I/O layer may bounce the buffer again, e.g. above 4 GB.
+  //
+  if (EmmcCrossesAdmaBoundary (*DeviceAddress, *NumberOfBytes)) {
+    mPciIoUnmap (This, Bounce->Mapping);
+    Status = EFI_OUT_OF_RESOURCES;
+    goto Error;
+  }
+
+  OldTpl = gBS->RaiseTPL (TPL_NOTIFY);
+  InsertTailList (&mBounceMappings, &Bounce->Link);
+  gBS->RestoreTPL (OldTpl);
+
+  *Mapping = Bounce;
+  return EFI_SUCCESS;
+
+Error:
+  DEBUG ((DEBUG_ERROR, "%a: Failed to bounce 0x%p. Status=%r\n", __FUNCTION__, HostAddress, Status));
+  if (Bounce->Buffer != NULL) {
+    FreeAlignedPages (Bounce->Buffer, Bounce->Pages);
+  }
+
+  FreePool (Bounce);
+  return Status;
+}
+
+/**
+  PCI I/O Unmap() wrapper for the SDHCI controller, releasing bounce
+  buffers set up by EmmcPciIoMap().
+
+  See EFI_PCI_IO_PROTOCOL.Unmap() for the parameters.
+
+**/
+STATIC
+EFI_STATUS
+EFIAPI
+EmmcPciIoUnmap (
+  IN EFI_PCI_IO_PROTOCOL  *This,
+  IN VOID                 *Mapping
+  )
+{
+  EFI_STATUS           Status;
+  LIST_ENTRY           *Link;
+  EMMC_BOUNCE_MAPPING  *Bounce;
+  EFI_TPL              OldTpl;
+
+  Bounce = NULL;
+
+  OldTpl = gBS->RaiseTPL (TPL_NOTIFY);
+  for (Link = GetFirstNode (&mBounceMappings);
+       !IsNull (&mBounceMappings, Link);
+       Link = GetNextNode (&mBounceMappings, Link))
+  {
+    if (Link == Mapping) {
+      Bounce = (EMMC_BOUNCE_MAPPING *)Link;
+      RemoveEntryList (Link);
+      break;
+    }
+  }
+
+  gBS->RestoreTPL (OldTpl);
+
+  if (Bounce == NULL) {
+    return mPciIoUnmap (This, Mapping);
+  }
+
+  Status = mPciIoUnmap (This, Bounce->Mapping);
+
+  if ((Bounce->Operation == EfiPciIoOperationBusMasterWrite) ||
+      (Bounce->Operation == EfiPciIoOperationBusMasterWrite64))
+  {
+    CopyMem (Bounce->HostAddress, Bounce->Buffer, Bounce->NumberOfBytes);
+  }
+
+  FreeAlignedPages (Bounce->Buffer, Bounce->Pages);
+  FreePool (Bounce);
+
+  return Status;
+}
+
+/**
+  Hook Map() and Unmap() of the controller's PCI I/O protocol as soon as
+  it has been installed.
+
+  @param[in]  Event     The protocol notify event.
+  @param[in]  Context   Unused.
+
+**/
+STATIC
+VOID
+EFIAPI
+EmmcOnPciIoInstalled (
+  IN EFI_EVENT  Event,
+  IN VOID       *Context
+  )
+{
+  EFI_STATUS           Status;
+  EFI_PCI_IO_PROTOCOL  *PciIo;
+
+  Status = gBS->HandleProtocol (
+                  mSdMmcControllerHandle,
+                  &gEfiPciIoProtocolGuid,
+                  (VOID **)&PciIo
+                  );
+  if (EFI_ERROR (Status)) {
+    return;
+  }
+
+  gBS->CloseEvent (Event);
+
+  mPciIoMap    = PciIo->Map;
+  mPciIoUnmap  = PciIo->Unmap;
+  PciIo->Map   = EmmcPciIoMap;
+  PciIo->Unmap = EmmcPciIoUnmap;
+}
+
 /**
   Override function for SDHCI capability bits
 
@@ -61,13 +309,13 @@ EmmcSdMmcCapability (
   }
 
   //
-  // Disable ADMA2 to avoid data corruption.
-  // This controller has the limitation that a single descriptor
-  // cannot cross 128 MB boundaries and must be split.
-  // This would require a patch in SdMmcPciHcDxe, but SDMA works
-  // fine for the time being.
+  // This controller has the limitation that a single ADMA2 descriptor
+  // cannot cross 128 MB boundaries. EmmcPciIoMap() makes sure that no
+  // data buffer does.
   //
-  Capability->Adma2 = 0;
+  if (EMMC_DISABLE_ADMA2) {
+    Capability->Adma2 = 0;
+  }
 
   Capability->Hs400 = !EMMC_DISABLE_HS400;
 
@@ -259,6 +507,7 @@ DwcSdhciDxeInitialize (
 {
   EFI_STATUS  Status;
   EFI_HANDLE  Handle;
+  EFI_EVENT   Event;
 
   DEBUG ((DEBUG_BLKIO, "%a\n", __FUNCTION__));
 
@@ -288,6 +537,28 @@ DwcSdhciDxeInitialize (
              );
   ASSERT_EFI_ERROR (Status);
 
+  //
+  // Hook the PCI I/O protocol once NonDiscoverablePciDeviceDxe has
+  // installed it on the controller, before SdMmcPciHcDxe binds to it.
+  //
+  if (!EMMC_DISABLE_ADMA2) {
+    Status = gBS->CreateEvent (
+                    EVT_NOTIFY_SIGNAL,
+                    TPL_CALLBACK,
+                    EmmcOnPciIoInstalled,
+                    NULL,
+                    &Event
+                    );
+    ASSERT_EFI_ERROR (Status);
+
+    Status = gBS->RegisterProtocolNotify (
+                    &gEfiPciIoProtocolGuid,
+                    Event,
+                    &mPciIoRegistration
+                    );
+    ASSERT_EFI_ERROR (Status);
+  }
+
   Handle = NULL;
   Status = gBS->InstallProtocolInterface (
                   &Handle,
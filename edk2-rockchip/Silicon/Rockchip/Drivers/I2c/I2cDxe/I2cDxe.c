@@ -172,6 +172,36 @@ I2cVirtualAddressChangeNotify (
   EfiConvertPointer (0x0, (VOID **)&I2cMasterContext->I2cMaster.StartRequest);
 }
 
+STATIC
+VOID
+EFIAPI
+I2cReportStatistics (
+  IN EFI_EVENT  Event,
+  IN VOID       *Context
+  )
+{
+  I2C_MASTER_CONTEXT  *I2cMasterContext = Context;
+
+  gBS->CloseEvent (Event);
+
+  if (I2cMasterContext->TransferCount == 0) {
+    return;
+  }
+
+  DEBUG ((
+    DEBUG_INFO,
+    "I2C%d: %lu transfers (%lu failed), %lu bytes at %u Hz, %lu us total, %lu us avg, %lu us max\n",
+    I2cMasterContext->Bus,
+    I2cMasterContext->TransferCount,
+    I2cMasterContext->TransferErrors,
+    I2cMasterContext->TransferBytes,
+    I2cMasterContext->BusClockHertz,
+    I2cMasterContext->TransferTimeNs / 1000,
+    I2cMasterContext->TransferTimeNs / I2cMasterContext->TransferCount / 1000,
+    I2cMasterContext->TransferMaxTimeNs / 1000
+    ));
+}
+
 EFI_STATUS
 EFIAPI
 I2cInitialiseController (
@@ -179,6 +209,7 @@ I2cInitialiseController (
   IN EFI_SYSTEM_TABLE      *SystemTable,
   IN EFI_PHYSICAL_ADDRESS  BaseAddress,
   IN UINT32                BusId,
+  IN UINT32                MaxBusClockHertz,
   IN BOOLEAN               RuntimeSupport
   )
 {
@@ -186,6 +217,7 @@ I2cInitialiseController (
   I2C_MASTER_CONTEXT  *I2cMasterContext;
   I2C_DEVICE_PATH     *DevicePath;
   EFI_EVENT           VirtualAddressChangeEvent = NULL;
+  EFI_EVENT           ReadyToBootEvent;
 
   DEBUG ((DEBUG_VERBOSE, "I2cInitialiseController\n"));
   DevicePath = AllocateCopyPool (
@@ -221,6 +253,7 @@ I2cInitialiseController (
   I2cMasterContext->BaseAddress                          = BaseAddress;
   I2cMasterContext->Bus                                  = BusId;
   I2cMasterContext->RuntimeSupport                       = RuntimeSupport;
+  I2cMasterContext->MaxBusClockHertz                     = MaxBusClockHertz;
 
   if (RuntimeSupport) {
     Status = gDS->AddMemorySpace (
@@ -273,18 +306,17 @@ I2cInitialiseController (
     }
   }
 
-  if (I2cGetVersion (I2cMasterContext) >= RkI2cVersion1) {
-    I2cAdapterBaudRate (
-      I2cMasterContext,
-      PcdGet32 (PcdI2cBaudRate),
-      I2cMasterContext->TclkFrequency
-      );
-  } else {
-    I2cCalBaudRate (
-      I2cMasterContext,
-      PcdGet32 (PcdI2cBaudRate),
-      I2cMasterContext->TclkFrequency
-      );
+  Status = I2cSetBaudRate (I2cMasterContext, MaxBusClockHertz);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((
+      DEBUG_ERROR,
+      "%a: Failed to set bus %d clock to %u Hz. Status=%r\n",
+      __FUNCTION__,
+      BusId,
+      MaxBusClockHertz,
+      Status
+      ));
+    goto fail;
   }
 
   Status = gBS->InstallMultipleProtocolInterfaces (
@@ -307,7 +339,20 @@ I2cInitialiseController (
     goto fail;
   }
 
-  DEBUG ((DEBUG_INFO, "Succesfully installed controller %d at 0x%llx\n", BusId, I2cMasterContext->BaseAddress));
+  EfiCreateEventReadyToBootEx (
+    TPL_CALLBACK,
+    I2cReportStatistics,
+    I2cMasterContext,
+    &ReadyToBootEvent
+    );
+
+  DEBUG ((
+    DEBUG_INFO,
+    "Succesfully installed controller %d at 0x%llx (%u Hz)\n",
+    BusId,
+    I2cMasterContext->BaseAddress,
+    I2cMasterContext->BusClockHertz
+    ));
   return EFI_SUCCESS;
 
 fail:
@@ -378,14 +423,22 @@ I2cInitialise (
   UINT8                 *DeviceBusPcd;
   UINT32                DeviceBusCount;
   UINT8                 *BusRuntimeSupport;
+  UINT32                *DeviceMaxBaudRates;
+  UINT32                DeviceMaxBaudRateCount;
+  UINT32                DeviceBaudRate;
+  UINT32                MaxBusClockHertz;
   EFI_STATUS            Status;
   UINTN                 Index;
+  UINTN                 Device;
   BOOLEAN               ConfiguredBuses[I2C_COUNT] = { 0 };
 
   DeviceBusPcd      = PcdGetPtr (PcdI2cSlaveBuses);
   DeviceBusCount    = PcdGetSize (PcdI2cSlaveBuses);
   BusRuntimeSupport = PcdGetPtr (PcdI2cSlaveBusesRuntimeSupport);
 
+  DeviceMaxBaudRates     = PcdGetPtr (PcdI2cSlaveMaxBaudRates);
+  DeviceMaxBaudRateCount = PcdGetSize (PcdI2cSlaveMaxBaudRates) / sizeof (UINT32);
+
   /* Initialize enabled chips */
   for (Index = 0; Index < DeviceBusCount; Index++) {
     if (DeviceBusPcd[Index] > I2C_COUNT - 1) {
@@ -419,11 +472,35 @@ I2cInitialise (
 
     I2cIomux (DeviceBusPcd[Index]);
 
+    //
+    // Run the bus at the fastest mode supported by all of its devices.
+    // Devices without an entry in PcdI2cSlaveMaxBaudRates are assumed
+    // to only support the default PcdI2cBaudRate.
+    //
+    MaxBusClockHertz = I2C_MAX_BUS_CLOCK_HZ;
+    for (Device = 0; Device < DeviceBusCount; Device++) {
+      if (DeviceBusPcd[Device] != DeviceBusPcd[Index]) {
+        continue;
+      }
+
+      DeviceBaudRate = 0;
+      if (Device < DeviceMaxBaudRateCount) {
+        DeviceBaudRate = ReadUnaligned32 (&DeviceMaxBaudRates[Device]);
+      }
+
+      if (DeviceBaudRate == 0) {
+        DeviceBaudRate = PcdGet32 (PcdI2cBaudRate);
+      }
+
+      MaxBusClockHertz = MIN (MaxBusClockHertz, DeviceBaudRate);
+    }
+
     Status = I2cInitialiseController (
                ImageHandle,
                SystemTable,
                BaseAddress,
                DeviceBusPcd[Index],
+               MaxBusClockHertz,
                BusRuntimeSupport[Index]
                );
 
@@ -542,6 +619,49 @@ I2cAdapterBaudRate (
   return EFI_SUCCESS;
 }
 
+/*
+ * Program the SCL dividers for the fastest rate not above Target and
+ * record the resulting bus clock.
+ */
+STATIC
+EFI_STATUS
+I2cSetBaudRate (
+  IN I2C_MASTER_CONTEXT  *I2cMasterContext,
+  IN UINT32              Target
+  )
+{
+  EFI_STATUS  Status;
+  UINT32      ClkDiv;
+  UINT32      Div;
+
+  if (I2cGetVersion (I2cMasterContext) >= RkI2cVersion1) {
+    Status = I2cAdapterBaudRate (
+               I2cMasterContext,
+               Target,
+               I2cMasterContext->TclkFrequency
+               );
+    if (EFI_ERROR (Status)) {
+      return Status;
+    }
+  } else {
+    I2cCalBaudRate (
+      I2cMasterContext,
+      Target,
+      I2cMasterContext->TclkFrequency
+      );
+  }
+
+  //
+  // SCL period is 8 * (DIVL + 1 + DIVH + 1) input clock cycles.
+  //
+  ClkDiv = I2cRead (I2cMasterContext, I2C_CLKDIV);
+  Div    = (ClkDiv & 0xffff) + (ClkDiv >> I2C_CLK_DIV_HIGH_SHIFT) + 2;
+
+  I2cMasterContext->BusClockHertz = I2cMasterContext->TclkFrequency / (8 * Div);
+
+  return EFI_SUCCESS;
+}
+
 STATIC
 EFI_STATUS
 EFIAPI
@@ -550,12 +670,25 @@ I2cSetBusFrequency (
   IN OUT UINTN                      *BusClockHertz
   )
 {
+  I2C_MASTER_CONTEXT  *I2cMasterContext = I2C_SC_FROM_MASTER (This);
+  EFI_STATUS          Status;
+
   //
-  // Bus frequency is already set in the entry point.
+  // The bus is set up in the entry point for the fastest mode supported by
+  // all of its devices. Callers may lower it, but never raise it beyond that.
   //
   // Note that this function is only called by some RTC drivers,
   // the I2C I/O upper layer doesn't make any use of it yet.
   //
+  Status = I2cSetBaudRate (
+             I2cMasterContext,
+             (UINT32)MIN (*BusClockHertz, I2cMasterContext->MaxBusClockHertz)
+             );
+  if (EFI_ERROR (Status)) {
+    return EFI_UNSUPPORTED;
+  }
+
+  *BusClockHertz = I2cMasterContext->BusClockHertz;
 
   return EFI_SUCCESS;
 }
@@ -583,6 +716,42 @@ I2cDisable (
   I2cWrite (I2cMasterContext, I2C_CON, 0);
 }
 
+/*
+ * Busy-poll I2C_IPD until one of the bits in Mask is pending, then clear it.
+ * A NAK is reported as EFI_NO_RESPONSE when I2C_NAKRCVIPD is part of Mask.
+ * Timeout is given in us.
+ */
+STATIC
+EFI_STATUS
+I2cWaitIpd (
+  IN I2C_MASTER_CONTEXT  *I2cMasterContext,
+  IN UINT32              Mask,
+  IN UINTN               Timeout
+  )
+{
+  UINT64  Start;
+  UINT32  Ipd;
+
+  Start = GetPerformanceCounter ();
+
+  for ( ; ; ) {
+    Ipd = I2cRead (I2cMasterContext, I2C_IPD) & Mask;
+    if (Ipd & I2C_NAKRCVIPD) {
+      I2cWrite (I2cMasterContext, I2C_IPD, I2C_NAKRCVIPD);
+      return EFI_NO_RESPONSE;
+    }
+
+    if (Ipd != 0) {
+      I2cWrite (I2cMasterContext, I2C_IPD, Ipd);
+      return EFI_SUCCESS;
+    }
+
+    if (GetTimeInNanoSecond (GetPerformanceCounter () - Start) >= (UINT64)Timeout * 1000) {
+      return EFI_TIMEOUT;
+    }
+  }
+}
+
 /*
  * enable and start at same time, Timeout is given in us.
  */
@@ -594,22 +763,16 @@ I2cStartEnable (
   IN UINTN               Timeout
   )
 {
+  EFI_STATUS  Status;
+
   DEBUG ((DEBUG_VERBOSE, "I2cStartEnable\n"));
 
   I2cWrite (I2cMasterContext, I2C_IPD, I2C_IPD_ALL_CLEAN);
   I2cWrite (I2cMasterContext, I2C_IEN, I2C_STARTIEN);
   I2cWrite (I2cMasterContext, I2C_CON, I2C_CON_EN | I2C_CON_START | Con |I2cMasterContext->Config);
 
-  while (Timeout--) {
-    if (I2cRead (I2cMasterContext, I2C_IPD) & I2C_STARTIPD) {
-      I2cWrite (I2cMasterContext, I2C_IPD, I2C_STARTIPD);
-      break;
-    }
-
-    MicroSecondDelay (1);
-  }
-
-  if (Timeout <= 0) {
+  Status = I2cWaitIpd (I2cMasterContext, I2C_STARTIPD, Timeout);
+  if (EFI_ERROR (Status)) {
     DEBUG ((DEBUG_ERROR, "I2C Send Start Bit Timeout\n"));
     I2cShowRegs (I2cMasterContext);
     return EFI_TIMEOUT;
@@ -624,7 +787,7 @@ I2cStop (
   IN I2C_MASTER_CONTEXT  *I2cMasterContext
   )
 {
-  int  TimeOut = I2C_READY_TIMEOUT;
+  EFI_STATUS  Status;
 
   DEBUG ((DEBUG_VERBOSE, "I2c Send Stop bit.\n"));
 
@@ -632,16 +795,8 @@ I2cStop (
   I2cWrite (I2cMasterContext, I2C_CON, I2C_CON_EN | I2C_CON_STOP |I2cMasterContext->Config);
   I2cWrite (I2cMasterContext, I2C_IEN, I2C_CON_STOP);
 
-  while (TimeOut--) {
-    if (I2cRead (I2cMasterContext, I2C_IPD) & I2C_STOPIPD) {
-      I2cWrite (I2cMasterContext, I2C_IPD, I2C_STOPIPD);
-      break;
-    }
-
-    MicroSecondDelay (1);
-  }
-
-  if (TimeOut <= 0) {
+  Status = I2cWaitIpd (I2cMasterContext, I2C_STOPIPD, I2C_READY_TIMEOUT);
+  if (EFI_ERROR (Status)) {
     DEBUG ((DEBUG_ERROR, "I2C Send Stop Bit Timeout\n"));
     I2cShowRegs (I2cMasterContext);
     return EFI_TIMEOUT;
@@ -650,11 +805,19 @@ I2cStop (
   return EFI_SUCCESS;
 }
 
+/*
+ * Read Length bytes from the slave. If RegLength is non-zero, the controller
+ * first transmits the (up to RK_I2C_REGISTER_SIZE bytes) register address in
+ * RegAddress and issues a repeated start on its own, so a write-then-read
+ * pair completes as a single TRX transaction.
+ */
 STATIC
 EFI_STATUS
 I2cReadOperation (
   IN I2C_MASTER_CONTEXT  *I2cMasterContext,
   IN UINTN               SlaveAddress,
+  IN CONST UINT8         *RegAddress,
+  IN UINTN               RegLength,
   IN OUT UINT8           *Buf,
   IN UINTN               Length,
   IN OUT UINTN           *Read,
@@ -663,22 +826,26 @@ I2cReadOperation (
   )
 {
   EFI_STATUS  Status            = EFI_SUCCESS;
-  int         TimeOut           = I2C_TIMEOUT_US;
   UINT8       *PBuf             = Buf;
   UINT32      BytesRemainLen    = Length;
   UINT32      BytesTranferedLen = 0;
   UINT32      WordsTranferedLen = 0;
   UINT32      Con               = 0;
+  UINT32      LastCon           = 0;
+  UINT32      RegValue;
   UINT32      RxData;
   UINT32      i, j;
   UINTN       SndChunk = 0;
 
+  ASSERT (RegLength <= RK_I2C_REGISTER_SIZE);
+
   DEBUG ((
     DEBUG_VERBOSE,
-    "I2cRead: base_addr = 0x%x buf = %p, Length = %d\n",
+    "I2cRead: base_addr = 0x%x buf = %p, Length = %d, RegLength = %d\n",
     I2cMasterContext->BaseAddress,
     Buf,
-    Length
+    Length,
+    RegLength
     ));
 
   /* If the second message for TRX read, resetting internal state. */
@@ -686,7 +853,18 @@ I2cReadOperation (
     I2cWrite (I2cMasterContext, I2C_CON, 0);
   }
 
-  I2cWrite (I2cMasterContext, I2C_MRXADDR, I2C_MRXADDR_SET (1, SlaveAddress << 1 | 1));
+  if (RegLength > 0) {
+    RegValue = 0;
+    for (i = 0; i < RegLength; i++) {
+      RegValue |= RegAddress[i] << (i * 8);
+    }
+
+    I2cWrite (I2cMasterContext, I2C_MRXADDR, I2C_MRXADDR_SET (1, SlaveAddress << 1));
+    I2cWrite (I2cMasterContext, I2C_MRXRADDR, I2C_MRXRADDR_SET ((1 << RegLength) - 1, RegValue));
+  } else {
+    I2cWrite (I2cMasterContext, I2C_MRXADDR, I2C_MRXADDR_SET (1, SlaveAddress << 1 | 1));
+    I2cWrite (I2cMasterContext, I2C_MRXRADDR, 0);
+  }
 
   (*Read) = 0;
   while (BytesRemainLen) {
@@ -707,40 +885,34 @@ I2cReadOperation (
     /*
       * make sure we are in plain RX mode if we read a second chunk;
       * and first rx read need to send start bit.
+      * CON only needs rewriting when the mode or LASTACK changes.
       */
     if (SndChunk) {
       Con |= I2C_CON_MOD (I2C_MODE_RX);
-      I2cWrite (I2cMasterContext, I2C_CON, Con | I2cMasterContext->Config);
+      if (Con != LastCon) {
+        I2cWrite (I2cMasterContext, I2C_CON, Con | I2cMasterContext->Config);
+      }
     } else {
       Con   |= I2C_CON_MOD (I2C_MODE_TRX);
       Status = I2cStartEnable (I2cMasterContext, Con, I2C_TIMEOUT_US);
       if (EFI_ERROR (Status)) {
         goto out;
       }
-    }
 
-    I2cWrite (I2cMasterContext, I2C_IEN, I2C_MBRFIEN | I2C_NAKRCVIEN);
-    I2cWrite (I2cMasterContext, I2C_MRXCNT, BytesTranferedLen);
-
-    while (TimeOut--) {
-      if (I2cRead (I2cMasterContext, I2C_IPD) & I2C_NAKRCVIPD) {
-        I2cWrite (I2cMasterContext, I2C_IPD, I2C_NAKRCVIPD);
-        Status = EFI_NO_RESPONSE;
-        goto out;
-      }
+      I2cWrite (I2cMasterContext, I2C_IEN, I2C_MBRFIEN | I2C_NAKRCVIEN);
+    }
 
-      if (I2cRead (I2cMasterContext, I2C_IPD) & I2C_MBRFIPD) {
-        I2cWrite (I2cMasterContext, I2C_IPD, I2C_MBRFIPD);
-        break;
-      }
+    LastCon = Con;
 
-      MicroSecondDelay (1);
-    }
+    I2cWrite (I2cMasterContext, I2C_MRXCNT, BytesTranferedLen);
 
-    if (TimeOut <= 0) {
+    Status = I2cWaitIpd (I2cMasterContext, I2C_MBRFIPD | I2C_NAKRCVIPD, I2C_TIMEOUT_US);
+    if (Status == EFI_TIMEOUT) {
       DEBUG ((DEBUG_ERROR, "I2C Read Data Timeout\n"));
       I2cShowRegs (I2cMasterContext);
-      Status = EFI_TIMEOUT;
+    }
+
+    if (EFI_ERROR (Status)) {
       goto out;
     }
 
@@ -758,7 +930,7 @@ I2cReadOperation (
 
     BytesRemainLen -= BytesTranferedLen;
     SndChunk        = 1;
-    (*Read)         = BytesTranferedLen;
+    (*Read)        += BytesTranferedLen;
   }
 
   Status  = EFI_SUCCESS;
@@ -780,7 +952,6 @@ I2cWriteOperation (
   )
 {
   EFI_STATUS   Status            = EFI_SUCCESS;
-  int          TimeOut           = I2C_TIMEOUT_US;
   CONST UINT8  *PBuf             = Buf;
   UINT32       BytesRemainLen    = Length + 1;
   UINT32       BytesTranferedLen = 0;
@@ -826,7 +997,11 @@ I2cWriteOperation (
       DEBUG ((DEBUG_VERBOSE, "I2c Write TXDATA[%d] = 0x%x\n", i, TxData));
     }
 
-    /* If the write is the first, need to send start bit */
+    /*
+     * If the write is the first, need to send start bit.
+     * The controller stays in TX mode for the following chunks,
+     * so writing MTXCNT is enough to send them.
+     */
     if (!Next) {
       Status = I2cStartEnable (
                  I2cMasterContext,
@@ -838,43 +1013,24 @@ I2cWriteOperation (
         goto out;
       }
 
+      I2cWrite (I2cMasterContext, I2C_IEN, I2C_MBTFIEN | I2C_NAKRCVIEN);
       Next = 1;
-    } else {
-      I2cWrite (
-        I2cMasterContext,
-        I2C_CON,
-        I2C_CON_EN |
-        I2C_CON_MOD (I2C_MODE_TX) | I2cMasterContext->Config
-        );
     }
 
-    I2cWrite (I2cMasterContext, I2C_IEN, I2C_MBTFIEN | I2C_NAKRCVIEN);
     I2cWrite (I2cMasterContext, I2C_MTXCNT, BytesTranferedLen);
 
-    while (TimeOut--) {
-      if (I2cRead (I2cMasterContext, I2C_IPD) & I2C_NAKRCVIPD) {
-        I2cWrite (I2cMasterContext, I2C_IPD, I2C_NAKRCVIPD);
-        Status = EFI_NO_RESPONSE;
-        goto out;
-      }
-
-      if (I2cRead (I2cMasterContext, I2C_IPD) & I2C_MBTFIPD) {
-        I2cWrite (I2cMasterContext, I2C_IPD, I2C_MBTFIPD);
-        break;
-      }
-
-      MicroSecondDelay (1);
-    }
-
-    if (TimeOut <= 0) {
+    Status = I2cWaitIpd (I2cMasterContext, I2C_MBTFIPD | I2C_NAKRCVIPD, I2C_TIMEOUT_US);
+    if (Status == EFI_TIMEOUT) {
       DEBUG ((DEBUG_ERROR, "I2C Write Data Timeout\n"));
       I2cShowRegs (I2cMasterContext);
-      Status = EFI_TIMEOUT;
+    }
+
+    if (EFI_ERROR (Status)) {
       goto out;
     }
 
     BytesRemainLen -= BytesTranferedLen;
-    (*Sent)         = BytesTranferedLen;
+    (*Sent)         = PBuf - Buf;
   }
 
   (*Sent) = Length;
@@ -898,14 +1054,16 @@ I2cStartRequest (
   )
 {
   UINTN               Count = RequestPacket->OperationCount;
-  UINTN               ReadMode;
   UINTN               Transmitted;
   I2C_MASTER_CONTEXT  *I2cMasterContext = I2C_SC_FROM_MASTER (This);
   EFI_I2C_OPERATION   *Operation;
   EFI_STATUS          Status = EFI_SUCCESS;
+  EFI_STATUS          StopStatus;
   UINTN               i;
   BOOLEAN             AtRuntime;
   EFI_TPL             Tpl;
+  UINT64              StartTime;
+  UINT64              ElapsedNs;
 
   ASSERT (RequestPacket != NULL);
   ASSERT (I2cMasterContext != NULL);
@@ -932,27 +1090,48 @@ I2cStartRequest (
     //
   }
 
-  if ((Count > 2) || ((Count == 2) && (RequestPacket->Operation->Flags & I2C_FLAG_READ))) {
-    DEBUG ((DEBUG_VERBOSE, "Not support more messages now, split them\n"));
-    return EFI_INVALID_PARAMETER;
-  }
+  StartTime = GetPerformanceCounter ();
 
   for (i = 0; i < Count; i++) {
     Operation = &RequestPacket->Operation[i];
-    ReadMode  = Operation->Flags & I2C_FLAG_READ;
 
     if (Operation->Flags & I2C_FLAG_READ) {
       /* If snd is true, it is TRX mode. */
       Status = I2cReadOperation (
                  I2cMasterContext,
                  SlaveAddress,
+                 NULL,
+                 0,
                  Operation->Buffer,
                  Operation->LengthInBytes,
                  &Transmitted,
-                 i == 1,
+                 i > 0,
                  I2C_TRANSFER_TIMEOUT
                  );
       Operation->LengthInBytes = Transmitted;
+    } else if ((i + 1 < Count) &&
+               (Operation[1].Flags & I2C_FLAG_READ) &&
+               (Operation->LengthInBytes > 0) &&
+               (Operation->LengthInBytes <= RK_I2C_REGISTER_SIZE))
+    {
+      //
+      // Coalesce a register address write and the read following it
+      // into a single combined transaction.
+      //
+      Status = I2cReadOperation (
+                 I2cMasterContext,
+                 SlaveAddress,
+                 Operation->Buffer,
+                 Operation->LengthInBytes,
+                 Operation[1].Buffer,
+                 Operation[1].LengthInBytes,
+                 &Transmitted,
+                 i > 0,
+                 I2C_TRANSFER_TIMEOUT
+                 );
+      I2cMasterContext->TransferBytes += Operation->LengthInBytes;
+      Operation[1].LengthInBytes       = Transmitted;
+      i++;
     } else {
       Status = I2cWriteOperation (
                  I2cMasterContext,
@@ -965,16 +1144,34 @@ I2cStartRequest (
       Operation->LengthInBytes = Transmitted;
     }
 
+    I2cMasterContext->TransferBytes += Transmitted;
+
     /* I2C transaction was aborted, so stop further transactions */
     if (EFI_ERROR (Status)) {
-      DEBUG ((DEBUG_VERBOSE, "I2cStartRequest: Failed at Count = %d\n", Count));
+      DEBUG ((DEBUG_VERBOSE, "I2cStartRequest: Failed at Count = %d\n", i));
       break;
     }
   }
 
-  I2cStop (I2cMasterContext);
+  StopStatus = I2cStop (I2cMasterContext);
   I2cDisable (I2cMasterContext);
 
+  if (!EFI_ERROR (Status)) {
+    Status = StopStatus;
+  }
+
+  ElapsedNs = GetTimeInNanoSecond (GetPerformanceCounter () - StartTime);
+
+  I2cMasterContext->TransferCount++;
+  I2cMasterContext->TransferTimeNs += ElapsedNs;
+  if (ElapsedNs > I2cMasterContext->TransferMaxTimeNs) {
+    I2cMasterContext->TransferMaxTimeNs = ElapsedNs;
+  }
+
+  if (EFI_ERROR (Status)) {
+    I2cMasterContext->TransferErrors++;
+  }
+
   if (!AtRuntime) {
     gBS->RestoreTPL (Tpl);
   } else if (I2cMasterContext->RuntimeSupport) {
@@ -982,14 +1179,15 @@ I2cStartRequest (
   }
 
   if (I2cStatus != NULL) {
-    *I2cStatus = EFI_SUCCESS;
+    *I2cStatus = Status;
   }
 
   if (Event != NULL) {
     gBS->SignalEvent (Event);
+    return EFI_SUCCESS;
   }
 
-  return EFI_SUCCESS;
+  return Status;
 }
 
 STATIC CONST EFI_GUID  DevGuid = I2C_GUID;
@@ -60,6 +60,9 @@
 #define I2C_TIMEOUT_US   100000         // 100000us = 100ms
 #define I2C_RETRY_COUNT  3
 
+/* fast mode plus */
+#define I2C_MAX_BUS_CLOCK_HZ  1000000
+
 #define I2C_ADAP_SEL_BIT(nr)   ((nr) + 11)
 #define I2C_ADAP_SEL_MASK(nr)  ((nr) + 27)
 
@@ -152,6 +155,13 @@ typedef struct {
   INTN                                             Bus;
   UINTN                                            Config;
   BOOLEAN                                          RuntimeSupport;
+  UINT32                                           BusClockHertz;
+  UINT32                                           MaxBusClockHertz;
+  UINT64                                           TransferCount;
+  UINT64                                           TransferErrors;
+  UINT64                                           TransferBytes;
+  UINT64                                           TransferTimeNs;
+  UINT64                                           TransferMaxTimeNs;
   EFI_I2C_MASTER_PROTOCOL                          I2cMaster;
   EFI_I2C_ENUMERATE_PROTOCOL                       I2cEnumerate;
   EFI_I2C_BUS_CONFIGURATION_MANAGEMENT_PROTOCOL    I2cBusConf;
@@ -226,6 +236,13 @@ I2cAdapterBaudRate (
   IN CONST UINT32        ClkRate
   );
 
+STATIC
+EFI_STATUS
+I2cSetBaudRate (
+  IN I2C_MASTER_CONTEXT  *I2cMasterContext,
+  IN UINT32              Target
+  );
+
 STATIC
 EFI_STATUS
 EFIAPI
@@ -260,16 +277,26 @@ I2cStop (
   IN I2C_MASTER_CONTEXT  *I2cMasterContext
   );
 
+STATIC
+EFI_STATUS
+I2cWaitIpd (
+  IN I2C_MASTER_CONTEXT  *I2cMasterContext,
+  IN UINT32              Mask,
+  IN UINTN               Timeout
+  );
+
 STATIC
 EFI_STATUS
 I2cReadOperation (
   IN I2C_MASTER_CONTEXT  *I2cMasterContext,
   IN UINTN               SlaveAddress,
-  IN OUT UINT8           *buf,
-  IN UINTN               len,
-  IN OUT UINTN           *read,
-  IN UINTN               last,
-  IN UINTN               delay
+  IN CONST UINT8         *RegAddress,
+  IN UINTN               RegLength,
+  IN OUT UINT8           *Buf,
+  IN UINTN               Length,
+  IN OUT UINTN           *Read,
+  IN UINTN               Snd,
+  IN UINTN               Timeout
   );
 
 STATIC
@@ -277,10 +304,10 @@ EFI_STATUS
 I2cWriteOperation (
   IN I2C_MASTER_CONTEXT  *I2cMasterContext,
   IN UINTN               SlaveAddress,
-  IN OUT CONST UINT8     *buf,
-  IN UINTN               len,
-  IN OUT UINTN           *sent,
-  IN UINTN               timeout
+  IN OUT CONST UINT8     *Buf,
+  IN UINTN               Length,
+  IN OUT UINTN           *Sent,
+  IN UINTN               Timeout
   );
 
 STATIC
@@ -204,6 +204,77 @@ LcdGraphicsBlt (
   return EFI_SUCCESS;
 }
 
+//
+// Square tile size used by the rotated copies. 16 pixels make up
+// a full 64-byte cache line on either side of the copy.
+//
+#define LCD_BLT_TILE_SIZE  16
+
+/**
+  Copy a block of pixels between two differently oriented surfaces.
+
+  Pixel (X, Y) of the block is read from
+  Source[X * SourceXStride + Y * SourceYStride] and written to
+  Destination[X * DestinationXStride + Y * DestinationYStride].
+
+  The block is walked in square tiles, with Y as the inner loop, so the
+  destination should be contiguous along Y. Within a tile, the source
+  lines stay in the cache, and the destination is written in whole
+  cache lines, which suits the write-combined framebuffer.
+
+**/
+STATIC
+VOID
+LcdGraphicsBltTiled (
+  OUT UINT32        *Destination,
+  IN  INTN          DestinationXStride,
+  IN  INTN          DestinationYStride,
+  IN  CONST UINT32  *Source,
+  IN  INTN          SourceXStride,
+  IN  INTN          SourceYStride,
+  IN  UINTN         Width,
+  IN  UINTN         Height
+  )
+{
+  UINTN         TileX;
+  UINTN         TileY;
+  UINTN         TileWidth;
+  UINTN         TileHeight;
+  UINTN         X;
+  UINTN         Y;
+  UINT32        *Dst;
+  CONST UINT32  *Src;
+
+  for (TileY = 0; TileY < Height; TileY += LCD_BLT_TILE_SIZE) {
+    TileHeight = MIN (LCD_BLT_TILE_SIZE, Height - TileY);
+
+    for (TileX = 0; TileX < Width; TileX += LCD_BLT_TILE_SIZE) {
+      TileWidth = MIN (LCD_BLT_TILE_SIZE, Width - TileX);
+
+      for (X = TileX; X < TileX + TileWidth; X++) {
+        Dst = Destination + (INTN)X * DestinationXStride + (INTN)TileY * DestinationYStride;
+        Src = Source + (INTN)X * SourceXStride + (INTN)TileY * SourceYStride;
+
+        for (Y = 0; Y < TileHeight; Y++) {
+          *Dst = *Src;
+          Dst += DestinationYStride;
+          Src += SourceYStride;
+        }
+      }
+    }
+  }
+}
+
+/**
+  Blt for panels mounted with a 90 degree rotation.
+
+  Logical pixel (X, Y) lives at scanline X, column (ScanLine - 1 - Y) of
+  the framebuffer. A logical column is therefore a contiguous run of
+  pixels in a single scanline, which is used for fills and video-to-video
+  copies. Transfers from/to a Blt buffer need a real transpose and go
+  through LcdGraphicsBltTiled().
+
+**/
 EFI_STATUS
 EFIAPI
 LcdGraphicsBlt90 (
@@ -221,16 +292,17 @@ LcdGraphicsBlt90 (
 {
   EFI_STATUS  Status;
   UINT32      *FrameBuffer;
-  UINT32      HorizontalResolution;
+  UINT32      ScanLine;
   UINTN       WidthInBytes;
+  UINTN       HeightInBytes;
   UINT32      *SourceBuffer;
   UINT32      *DestinationBuffer;
-  UINTN       Y;
   UINTN       X;
 
-  FrameBuffer          = (UINT32 *)This->Mode->FrameBufferBase;
-  HorizontalResolution = This->Mode->Info->VerticalResolution;
-  WidthInBytes         = Width * RK_BYTES_PER_PIXEL;
+  FrameBuffer   = (UINT32 *)This->Mode->FrameBufferBase;
+  ScanLine      = This->Mode->Info->VerticalResolution;
+  WidthInBytes  = Width * RK_BYTES_PER_PIXEL;
+  HeightInBytes = Height * RK_BYTES_PER_PIXEL;
 
   Status = LcdGraphicsBltCheckParameters (
              This,
@@ -250,16 +322,12 @@ LcdGraphicsBlt90 (
 
   switch (BltOperation) {
     case EfiBltVideoFill:
-      SourceBuffer = (UINT32 *)BltBuffer;
-
-      for (Y = 0; Y < Height; Y++) {
-        for (X = 0; X < Width; X++) {
-          DestinationBuffer = FrameBuffer +
-                              (HorizontalResolution - 1 - (DestinationY + Y)) +
-                              (DestinationX + X) * HorizontalResolution;
+      for (X = 0; X < Width; X++) {
+        DestinationBuffer = FrameBuffer +
+                            (DestinationX + X) * ScanLine +
+                            (ScanLine - (DestinationY + Height));
 
-          *DestinationBuffer = *SourceBuffer;
-        }
+        SetMem32 (DestinationBuffer, HeightInBytes, *(UINT32 *)BltBuffer);
       }
 
       break;
@@ -269,19 +337,27 @@ LcdGraphicsBlt90 (
         Delta = WidthInBytes;
       }
 
-      for (Y = 0; Y < Height; Y++) {
-        for (X = 0; X < Width; X++) {
-          SourceBuffer = FrameBuffer +
-                         (HorizontalResolution - 1 - (SourceY + Y)) +
-                         (SourceX + X) * HorizontalResolution;
-
-          DestinationBuffer = (UINT32 *)((UINTN)BltBuffer +
-                                         (DestinationY + Y) * Delta +
-                                         (DestinationX + X) * RK_BYTES_PER_PIXEL);
-
-          *DestinationBuffer = *SourceBuffer;
-        }
-      }
+      SourceBuffer = FrameBuffer +
+                     SourceX * ScanLine +
+                     (ScanLine - 1 - SourceY);
+
+      DestinationBuffer = (UINT32 *)((UINTN)BltBuffer +
+                                     DestinationY * Delta +
+                                     DestinationX * RK_BYTES_PER_PIXEL);
+
+      //
+      // The Blt buffer is contiguous along X, so walk the block transposed.
+      //
+      LcdGraphicsBltTiled (
+        DestinationBuffer,
+        Delta / RK_BYTES_PER_PIXEL,
+        1,
+        SourceBuffer,
+        -1,
+        ScanLine,
+        Height,
+        Width
+        );
 
       break;
 
@@ -290,50 +366,55 @@ LcdGraphicsBlt90 (
         Delta = WidthInBytes;
       }
 
-      for (Y = 0; Y < Height; Y++) {
-        for (X = 0; X < Width; X++) {
-          SourceBuffer = (UINT32 *)((UINTN)BltBuffer +
-                                    (SourceY + Y) * Delta +
-                                    (SourceX + X) * RK_BYTES_PER_PIXEL);
-
-          DestinationBuffer = FrameBuffer +
-                              (HorizontalResolution - 1 - (DestinationY + Y)) +
-                              (DestinationX + X) * HorizontalResolution;
-
-          *DestinationBuffer = *SourceBuffer;
-        }
-      }
+      SourceBuffer = (UINT32 *)((UINTN)BltBuffer +
+                                SourceY * Delta +
+                                SourceX * RK_BYTES_PER_PIXEL);
+
+      DestinationBuffer = FrameBuffer +
+                          DestinationX * ScanLine +
+                          (ScanLine - 1 - DestinationY);
+
+      LcdGraphicsBltTiled (
+        DestinationBuffer,
+        ScanLine,
+        -1,
+        SourceBuffer,
+        1,
+        Delta / RK_BYTES_PER_PIXEL,
+        Width,
+        Height
+        );
 
       break;
 
     case EfiBltVideoToVideo:
-      if (SourceY < DestinationY) {
-        for (Y = Height; Y-- > 0;) {
-          for (X = 0; X < Width; X++) {
-            SourceBuffer = FrameBuffer +
-                           (HorizontalResolution - 1 - (SourceY + Y)) +
-                           (SourceX + X) * HorizontalResolution;
+      //
+      // Each logical column is a contiguous run within a scanline,
+      // CopyMem takes care of overlaps within it.
+      //
+      if (SourceX < DestinationX) {
+        for (X = Width; X-- > 0;) {
+          SourceBuffer = FrameBuffer +
+                         (SourceX + X) * ScanLine +
+                         (ScanLine - (SourceY + Height));
 
-            DestinationBuffer = FrameBuffer +
-                                (HorizontalResolution - 1 - (DestinationY + Y)) +
-                                (DestinationX + X) * HorizontalResolution;
+          DestinationBuffer = FrameBuffer +
+                              (DestinationX + X) * ScanLine +
+                              (ScanLine - (DestinationY + Height));
 
-            *DestinationBuffer = *SourceBuffer;
-          }
+          CopyMem (DestinationBuffer, SourceBuffer, HeightInBytes);
         }
       } else {
-        for (Y = 0; Y < Height; Y++) {
-          for (X = 0; X < Width; X++) {
-            SourceBuffer = FrameBuffer +
-                           (HorizontalResolution - 1 - (SourceY + Y)) +
-                           (SourceX + X) * HorizontalResolution;
+        for (X = 0; X < Width; X++) {
+          SourceBuffer = FrameBuffer +
+                         (SourceX + X) * ScanLine +
+                         (ScanLine - (SourceY + Height));
 
-            DestinationBuffer = FrameBuffer +
-                                (HorizontalResolution - 1 - (DestinationY + Y)) +
-                                (DestinationX + X) * HorizontalResolution;
+          DestinationBuffer = FrameBuffer +
+                              (DestinationX + X) * ScanLine +
+                              (ScanLine - (DestinationY + Height));
 
-            *DestinationBuffer = *SourceBuffer;
-          }
+          CopyMem (DestinationBuffer, SourceBuffer, HeightInBytes);
         }
       }
 
@@ -74,6 +74,7 @@ STATIC LCD_INSTANCE  mLcdTemplate = {
   { 0 },                                       // DisplayStates
   0,                                           // DisplayStatesCount
   NULL,                                        // DisplayModes
+  0,                                           // VramPages
 };
 
 STATIC
@@ -445,6 +446,25 @@ SetupAllDisplays (
   return EFI_SUCCESS;
 }
 
+//
+// Framebuffer resolutions offered in addition to the native one.
+// Only those smaller than the display timing and of the same aspect
+// ratio are exposed.
+//
+STATIC CONST UINT32  mScaledResolutions[][2] = {
+  { 2560, 1440 },
+  { 1920, 1200 },
+  { 1920, 1080 },
+  { 1680, 1050 },
+  { 1600, 1200 },
+  { 1600, 900  },
+  { 1440, 900  },
+  { 1280, 1024 },
+  { 1280, 800  },
+  { 1280, 720  },
+  { 1024, 768  },
+};
+
 STATIC
 EFI_STATUS
 GetSupportedDisplayModes (
@@ -455,17 +475,23 @@ GetSupportedDisplayModes (
   CONST DISPLAY_MODE                 *Mode;
   DISPLAY_MODE_PRESET_VARSTORE_DATA  *ModePreset;
   DISPLAY_SINK_INFO                  *SinkInfo;
+  LCD_MODE                           *LcdMode;
+  UINT32                             Width;
+  UINT32                             Height;
+  UINTN                              Index;
 
   //
-  // Only expose a single mode to GOP.
+  // Only a single display timing is ever used. GOP gets the native
+  // resolution as mode 0, followed by lower resolutions that VOP2
+  // scales up to it.
   //
   Instance->Gop.Mode->MaxMode = 1;
 
   Instance->Gop.Mode->Mode = MAX_UINT32;
 
   Instance->DisplayModes = AllocateZeroPool (
-                             sizeof (DISPLAY_MODE) *
-                             Instance->Gop.Mode->MaxMode
+                             sizeof (LCD_MODE) *
+                             (1 + ARRAY_SIZE (mScaledResolutions))
                              );
   if (Instance->DisplayModes == NULL) {
     ASSERT (FALSE);
@@ -528,7 +554,40 @@ GetSupportedDisplayModes (
     Mode = GetPredefinedDisplayMode (0);
   }
 
-  CopyMem (&Instance->DisplayModes[0], Mode, sizeof (*Mode));
+  LcdMode = &Instance->DisplayModes[0];
+  CopyMem (&LcdMode->Timing, Mode, sizeof (*Mode));
+  LcdMode->HorizontalResolution = Mode->HActive;
+  LcdMode->VerticalResolution   = Mode->VActive;
+
+  if (!FixedPcdGetBool (PcdDisplayScaledModes)) {
+    return EFI_SUCCESS;
+  }
+
+  for (Index = 0; Index < ARRAY_SIZE (mScaledResolutions); Index++) {
+    Width  = mScaledResolutions[Index][0];
+    Height = mScaledResolutions[Index][1];
+
+    if ((Width >= Mode->HActive) || (Height >= Mode->VActive) ||
+        (Width * Mode->VActive != Height * Mode->HActive))
+    {
+      continue;
+    }
+
+    LcdMode = &Instance->DisplayModes[Instance->Gop.Mode->MaxMode++];
+    CopyMem (&LcdMode->Timing, Mode, sizeof (*Mode));
+    LcdMode->HorizontalResolution = Width;
+    LcdMode->VerticalResolution   = Height;
+
+    DEBUG ((
+      DEBUG_INFO,
+      "%a: Scaled %ux%u -> %ux%u\n",
+      __func__,
+      Width,
+      Height,
+      Mode->HActive,
+      Mode->VActive
+      ));
+  }
 
   return EFI_SUCCESS;
 }
@@ -719,7 +778,7 @@ VOID
 LcdGraphicsSetModeInfo (
   IN  EFI_GRAPHICS_OUTPUT_PROTOCOL          *This,
   OUT EFI_GRAPHICS_OUTPUT_MODE_INFORMATION  *Info,
-  IN  CONST DISPLAY_MODE                    *DisplayMode,
+  IN  CONST LCD_MODE                        *DisplayMode,
   IN  BOOLEAN                               Update
   )
 {
@@ -731,12 +790,12 @@ LcdGraphicsSetModeInfo (
     //
     // Swap the reported resolution and only allow Blt operations.
     //
-    Info->HorizontalResolution = DisplayMode->VActive;
-    Info->VerticalResolution   = DisplayMode->HActive;
+    Info->HorizontalResolution = DisplayMode->VerticalResolution;
+    Info->VerticalResolution   = DisplayMode->HorizontalResolution;
     Info->PixelFormat          = PixelBltOnly;
   } else {
-    Info->HorizontalResolution = DisplayMode->HActive;
-    Info->VerticalResolution   = DisplayMode->VActive;
+    Info->HorizontalResolution = DisplayMode->HorizontalResolution;
+    Info->VerticalResolution   = DisplayMode->VerticalResolution;
     Info->PixelFormat          = PixelBlueGreenRedReserved8BitPerColor;
   }
 
@@ -771,7 +830,7 @@ LcdGraphicsQueryMode (
   )
 {
   LCD_INSTANCE  *Instance;
-  DISPLAY_MODE  *Mode;
+  LCD_MODE      *Mode;
 
   if ((This == NULL) ||
       (Info == NULL) ||
@@ -816,8 +875,7 @@ LcdGraphicsSetMode (
   EFI_PHYSICAL_ADDRESS           VramBaseAddress;
   UINTN                          VramSize;
   UINTN                          NumVramPages;
-  UINTN                          NumPreviousVramPages;
-  DISPLAY_MODE                   *Mode;
+  LCD_MODE                       *Mode;
   DRM_DISPLAY_MODE               *DrmMode;
   DISPLAY_STATE                  *DisplayState;
   ROCKCHIP_CRTC_PROTOCOL         *Crtc;
@@ -848,14 +906,18 @@ LcdGraphicsSetMode (
 
   VramBaseAddress = This->Mode->FrameBufferBase;
 
-  VramSize = Mode->HActive * Mode->VActive * RK_BYTES_PER_PIXEL;
+  VramSize = Mode->HorizontalResolution * Mode->VerticalResolution * RK_BYTES_PER_PIXEL;
 
-  NumVramPages         = EFI_SIZE_TO_PAGES (VramSize);
-  NumPreviousVramPages = EFI_SIZE_TO_PAGES (This->Mode->FrameBufferSize);
+  NumVramPages = EFI_SIZE_TO_PAGES (VramSize);
 
-  if (NumPreviousVramPages < NumVramPages) {
-    if (NumPreviousVramPages != 0) {
-      gBS->FreePages (VramBaseAddress, NumPreviousVramPages);
+  //
+  // FrameBufferSize follows the current mode, while the allocation only
+  // ever grows. Track its actual size separately.
+  //
+  if (Instance->VramPages < NumVramPages) {
+    if (Instance->VramPages != 0) {
+      gBS->FreePages (VramBaseAddress, Instance->VramPages);
+      Instance->VramPages         = 0;
       This->Mode->FrameBufferSize = 0;
     }
 
@@ -878,6 +940,8 @@ LcdGraphicsSetMode (
       return Status;
     }
 
+    Instance->VramPages = NumVramPages;
+
     Status = mCpu->SetMemoryAttributes (
                      mCpu,
                      VramBaseAddress,
@@ -937,8 +1001,8 @@ LcdGraphicsSetMode (
     ConnectorState = &DisplayState->ConnectorState;
     DrmMode        = &DisplayState->ConnectorState.DisplayMode;
 
-    DisplayModeToDrm (Mode, DrmMode);
-    ConnectorState->DisplayModeVic = Mode->Vic;
+    DisplayModeToDrm (&Mode->Timing, DrmMode);
+    ConnectorState->DisplayModeVic = Mode->Timing.Vic;
 
     DEBUG ((
       DEBUG_INFO,
@@ -972,10 +1036,10 @@ LcdGraphicsSetMode (
       }
     }
 
-    /* adapt to uefi display architecture */
+    /* adapt to uefi display architecture, VOP2 scales Src up to Crtc */
     CrtcState->Format  = ROCKCHIP_FMT_ARGB8888;
-    CrtcState->SrcW    = ConnectorState->DisplayMode.HDisplay;
-    CrtcState->SrcH    = ConnectorState->DisplayMode.VDisplay;
+    CrtcState->SrcW    = Mode->HorizontalResolution;
+    CrtcState->SrcH    = Mode->VerticalResolution;
     CrtcState->SrcX    = 0;
     CrtcState->SrcY    = 0;
     CrtcState->CrtcW   = ConnectorState->DisplayMode.HDisplay;
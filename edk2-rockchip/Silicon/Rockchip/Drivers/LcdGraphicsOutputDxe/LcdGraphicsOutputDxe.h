@@ -35,6 +35,16 @@ typedef struct {
   EFI_DEVICE_PATH_PROTOCOL    End;
 } LCD_GRAPHICS_DEVICE_PATH;
 
+//
+// A GOP mode. The framebuffer can be smaller than the display timing,
+// in which case VOP2 scales it up to fill the screen.
+//
+typedef struct {
+  DISPLAY_MODE    Timing;
+  UINT32          HorizontalResolution;
+  UINT32          VerticalResolution;
+} LCD_MODE;
+
 typedef struct {
   UINT32                                  Signature;
   EFI_HANDLE                              Handle;
@@ -44,7 +54,8 @@ typedef struct {
   LCD_GRAPHICS_DEVICE_PATH                DevicePath;
   DISPLAY_STATE                           *DisplayStates[VOP_OUTPUT_IF_NUMS];
   UINT32                                  DisplayStatesCount;
-  DISPLAY_MODE                            *DisplayModes;
+  LCD_MODE                                *DisplayModes;
+  UINTN                                   VramPages;
 } LCD_INSTANCE;
 
 #define LCD_INSTANCE_SIGNATURE  SIGNATURE_32('l', 'c', 'd', '0')
@@ -82,6 +82,9 @@ struct FLASH_INFO {
 
 #define READ_MAX_IOSIZE  (1024 * 8)/* 8KB */
 
+#define DMA_READ_MAX_IOSIZE  (1024 * 1024)/* 1MB */
+#define DMA_BOUNCE_SIZE      (1024 * 64)/* 64KB */
+
 /********************* Private Structure Definition **************************/
 
 /********************* Private Variable Definition ***************************/
@@ -209,6 +212,7 @@ static const struct FLASH_INFO  s_spiFlashbl[] = {
 STATIC struct HAL_FSPI_HOST     *g_spi;
 STATIC struct SPI_NOR           *g_nor;
 STATIC EFI_EVENT                mNorVirtualAddrChangeEvent;
+STATIC EFI_EVENT                mNorExitBootServicesEvent;
 
 /* Support single line case
  * - id: get from SPI Nor device information
@@ -630,6 +634,7 @@ HAL_SNOR_ReadData (
 {
   RETURN_STATUS  ret;
   UINT8          *pBuf = (UINT8 *)buf;
+  UINT8          *pDst;
   UINT32         size, remain = len;
 
   /* DEBUG ((DEBUG_SNOR, "%s from 0x%08lx, len %lx\n", __func__, from, len)); */
@@ -639,13 +644,35 @@ HAL_SNOR_ReadData (
 
   while (remain) {
     size = MIN (READ_MAX_IOSIZE, remain);
-    ret  = SNOR_ReadData (nor, from, size, pBuf);
+    pDst = pBuf;
+
+    /*
+     * Large reads go through DMA, either straight into the caller's buffer
+     * or staged through the bounce buffer. The unaligned tail stays on PIO.
+     */
+    if (nor->spi->dmaEnable && (remain >= HAL_FSPI_DMA_MIN_SIZE)) {
+      size = MIN (DMA_READ_MAX_IOSIZE, remain) & ~(HAL_FSPI_DMA_ALIGN - 1);
+      if (!HAL_FSPI_IsDmaCapable (nor->spi, pBuf, size)) {
+        if (nor->bounceBuf != NULL) {
+          size = MIN (nor->bounceSize, size);
+          pDst = nor->bounceBuf;
+        } else {
+          size = MIN (READ_MAX_IOSIZE, remain);
+        }
+      }
+    }
+
+    ret = SNOR_ReadData (nor, from, size, pDst);
     if (ret != (RETURN_STATUS)size) {
       DEBUG ((DEBUG_SNOR, "%s %lu ret= %ld\n", __func__, from >> 9, ret));
 
       return ret;
     }
 
+    if (pDst != pBuf) {
+      CopyMem (pBuf, pDst, size);
+    }
+
     remain -= size;
     from   += size;
     pBuf   += size;
@@ -672,6 +699,7 @@ HAL_SNOR_ProgData (
 {
   RETURN_STATUS  ret;
   UINT8          *pBuf = (UINT8 *)buf;
+  UINT8          *pSrc;
   UINT32         size, remain = len, pageOffset;
 
   /* DEBUG ((DEBUG_SNOR, "%s to 0x%08lx, len %lx\n", __func__, to, len)); */
@@ -682,8 +710,19 @@ HAL_SNOR_ProgData (
   while (remain) {
     pageOffset = to & (nor->pageSize - 1);
     size       = MIN (nor->pageSize - pageOffset, remain);
+    pSrc       = pBuf;
+
+    /* Stage full pages that DMA cannot reach directly */
+    if (nor->spi->dmaEnable && (nor->bounceBuf != NULL) &&
+        HAL_FSPI_IsDmaCapable (nor->spi, nor->bounceBuf, size) &&
+        !HAL_FSPI_IsDmaCapable (nor->spi, pBuf, size))
+    {
+      CopyMem (nor->bounceBuf, pBuf, size);
+      pSrc = nor->bounceBuf;
+    }
+
     SNOR_WriteEnable (nor);
-    ret = SNOR_WriteData (nor, to, size, pBuf);
+    ret = SNOR_WriteData (nor, to, size, pSrc);
     if (ret != (RETURN_STATUS)size) {
       DEBUG ((DEBUG_SNOR, "%s %lu ret= %ld\n", __func__, to >> 9, ret));
 
@@ -1146,62 +1185,177 @@ Read (
   return Status;
 }
 
+/* Update() engine: a sector is rewritten only when its content changes */
+#define UPDATE_BLOCK_SIZE  SIZE_64KB
+
+/* Dirty sectors in a 64KB block above which one block erase is cheaper */
+#define UPDATE_BLOCK_ERASE_THRESHOLD  4
+
+typedef enum {
+  SectorSkip = 0,   // Flash already holds the new data
+  SectorProgram,    // Only 1->0 bit transitions, program without erase
+  SectorErase       // Needs an erase before programming
+} SECTOR_UPDATE_ACTION;
+
+typedef struct {
+  UINT32    BlockErases;
+  UINT32    SectorErases;
+  UINT32    PagesProgrammed;
+  UINT32    SectorsSkipped;
+} UPDATE_STATS;
+
+STATIC
+SECTOR_UPDATE_ACTION
+SpiFlashClassifySector (
+  IN CONST UINT8  *Old,
+  IN CONST UINT8  *New,
+  IN UINTN        Size
+  )
+{
+  SECTOR_UPDATE_ACTION  Action;
+  UINTN                 Index;
+
+  Action = SectorSkip;
+  for (Index = 0; Index < Size; Index++) {
+    if (Old[Index] == New[Index]) {
+      continue;
+    }
+
+    // Programming can only clear bits
+    if ((Old[Index] & New[Index]) != New[Index]) {
+      return SectorErase;
+    }
+
+    Action = SectorProgram;
+  }
+
+  return Action;
+}
+
+/*
+ * Program the pages of New that differ from Old. After an erase, Old is
+ * all 0xFF so every page that is not blank gets programmed.
+ */
 STATIC
 EFI_STATUS
-SpiFlashUpdateBlock (
-  IN UINT32  Offset,
-  IN UINT32  Align,
-  IN UINTN   ToUpdate,
-  IN UINT8   *Buf,
-  IN UINT8   *TmpBuf,
-  IN UINTN   EraseSize
+SpiFlashProgramChangedPages (
+  IN UINT32        Offset,
+  IN CONST UINT8   *Old,
+  IN UINT8         *New,
+  IN UINTN         Size,
+  IN BOOLEAN       Erased,
+  IN UPDATE_STATS  *Stats
   )
 {
   EFI_STATUS  Status;
+  UINTN       Page;
+  UINTN       PageSize;
+  UINTN       Index;
+  BOOLEAN     Changed;
+
+  PageSize = g_nor->pageSize;
+  for (Page = 0; Page < Size; Page += PageSize) {
+    Changed = FALSE;
+    for (Index = Page; Index < Page + PageSize; Index++) {
+      if (New[Index] != (Erased ? 0xFF : Old[Index])) {
+        Changed = TRUE;
+        break;
+      }
+    }
 
-  if (EfiAtRuntime ()) {
-    NorFspiEnableClock (g_nor->spi->CruBase);
-  }
+    if (!Changed) {
+      continue;
+    }
 
-  // Read backup
-  if (ToUpdate != EraseSize) {
-    Status = HAL_SNOR_ReadData (g_nor, Offset - Align, TmpBuf, EraseSize);
-    if (EFI_ERROR (Status)) {
-      DEBUG ((DEBUG_ERROR, "SpiFlash: Update: Error while reading old data\n"));
-      return Status;
+    Status = HAL_SNOR_ProgData (g_nor, Offset + Page, &New[Page], PageSize);
+    if (Status != (RETURN_STATUS)PageSize) {
+      DEBUG ((DEBUG_ERROR, "SpiFlash: Update: Error while writing new data\n"));
+      return EFI_DEVICE_ERROR;
     }
+
+    Stats->PagesProgrammed++;
   }
 
-  // Erase entire sector
-  Status = HAL_SNOR_Erase (g_nor, Offset, ERASE_SECTOR);
-  if (EFI_ERROR (Status)) {
-    DEBUG ((DEBUG_ERROR, "SpiFlash: Update: Error while erasing block\n"));
-    return Status;
+  return EFI_SUCCESS;
+}
+
+/*
+ * Bring one 64KB block in line with New. Old holds the current flash
+ * content and is clobbered.
+ */
+STATIC
+EFI_STATUS
+SpiFlashUpdateBlock (
+  IN UINT32        Offset,
+  IN UINT8         *Old,
+  IN UINT8         *New,
+  IN UPDATE_STATS  *Stats
+  )
+{
+  EFI_STATUS            Status;
+  SECTOR_UPDATE_ACTION  Actions[UPDATE_BLOCK_SIZE / SIZE_4KB];
+  UINTN                 SectorSize;
+  UINTN                 Sectors;
+  UINTN                 Dirty;
+  UINTN                 Index;
+
+  SectorSize = g_nor->sectorSize;
+  Sectors    = UPDATE_BLOCK_SIZE / SectorSize;
+  Dirty      = 0;
+
+  for (Index = 0; Index < Sectors; Index++) {
+    Actions[Index] = SpiFlashClassifySector (
+                       &Old[Index * SectorSize],
+                       &New[Index * SectorSize],
+                       SectorSize
+                       );
+    if (Actions[Index] == SectorErase) {
+      Dirty++;
+    }
   }
 
-  if (Align) {
-    CopyMem (&TmpBuf[Align], Buf, ToUpdate);
-    Status = HAL_SNOR_ProgData (g_nor, Offset - Align, TmpBuf, EraseSize);
+  if (Dirty >= UPDATE_BLOCK_ERASE_THRESHOLD) {
+    Status = HAL_SNOR_Erase (g_nor, Offset, ERASE_BLOCK64K);
     if (EFI_ERROR (Status)) {
-      DEBUG ((DEBUG_ERROR, "SpiFlash: Update: Error while writing new data\n"));
+      DEBUG ((DEBUG_ERROR, "SpiFlash: Update: Error while erasing block\n"));
       return Status;
     }
 
-    return EFI_SUCCESS;
-  }
+    Stats->BlockErases++;
 
-  // Write new data
-  Status = HAL_SNOR_ProgData (g_nor, Offset, Buf, ToUpdate);
-  if (EFI_ERROR (Status)) {
-    DEBUG ((DEBUG_ERROR, "SpiFlash: Update: Error while writing new data\n"));
-    return Status;
+    return SpiFlashProgramChangedPages (Offset, Old, New, UPDATE_BLOCK_SIZE, TRUE, Stats);
   }
 
-  // Write backup
-  if (ToUpdate != EraseSize) {
-    Status = HAL_SNOR_ProgData (g_nor, Offset + ToUpdate, &TmpBuf[ToUpdate], EraseSize - ToUpdate);
+  for (Index = 0; Index < Sectors; Index++) {
+    switch (Actions[Index]) {
+      case SectorSkip:
+        Stats->SectorsSkipped++;
+        Status = EFI_SUCCESS;
+        break;
+
+      case SectorErase:
+        Status = HAL_SNOR_Erase (g_nor, Offset + Index * SectorSize, ERASE_SECTOR);
+        if (EFI_ERROR (Status)) {
+          DEBUG ((DEBUG_ERROR, "SpiFlash: Update: Error while erasing sector\n"));
+          return Status;
+        }
+
+        Stats->SectorErases++;
+      // Fall through
+
+      default:
+        Status = SpiFlashProgramChangedPages (
+                   Offset + Index * SectorSize,
+                   &Old[Index * SectorSize],
+                   &New[Index * SectorSize],
+                   SectorSize,
+                   Actions[Index] == SectorErase,
+                   Stats
+                   );
+        break;
+    }
+
     if (EFI_ERROR (Status)) {
-      DEBUG ((DEBUG_ERROR, "SpiFlash: Update: Error while writing backup\n"));
       return Status;
     }
   }
@@ -1217,39 +1371,95 @@ Update (
   UINT32                     ulLength
   )
 {
-  EFI_STATUS  Status = EFI_SUCCESS;
-  UINT64      SectorSize, ToUpdate, Align, Scale = 1;
-  UINT8       *TmpBuf, *End;
+  EFI_STATUS    Status = EFI_SUCCESS;
+  UINT32        BlockOffset, Align, ToUpdate, Remaining;
+  UINT8         *OldBuf, *NewBuf;
+  UINT64        Scale = 1;
+  UPDATE_STATS  Stats;
 
   // DEBUG ((DEBUG_ERROR, "[%a]:%x %x!......................\n", __FUNCTION__, Offset, ulLength));
 
-  SectorSize = g_nor->sectorSize;
-  Align      = Offset & (SectorSize -1);
-  End        = Buffer + ulLength;
+  //
+  // The clock must be on before the old content is read for the diff.
+  //
+  if (EfiAtRuntime ()) {
+    NorFspiEnableClock (g_nor->spi->CruBase);
+  }
+
+  if ((Offset >= g_nor->size) || (ulLength > g_nor->size - Offset) ||
+      (g_nor->size % UPDATE_BLOCK_SIZE) || (g_nor->sectorSize < SIZE_4KB) ||
+      (UPDATE_BLOCK_SIZE % g_nor->sectorSize) ||
+      (g_nor->sectorSize % g_nor->pageSize))
+  {
+    return EFI_INVALID_PARAMETER;
+  }
 
-  TmpBuf = (UINT8 *)AllocateZeroPool (SectorSize);
-  if (TmpBuf == NULL) {
+  OldBuf = (UINT8 *)AllocatePool (UPDATE_BLOCK_SIZE);
+  NewBuf = (UINT8 *)AllocatePool (UPDATE_BLOCK_SIZE);
+  if ((OldBuf == NULL) || (NewBuf == NULL)) {
     DEBUG ((DEBUG_ERROR, "SpiFlash: Cannot allocate memory\n"));
-    return EFI_OUT_OF_RESOURCES;
+    Status = EFI_OUT_OF_RESOURCES;
+    goto Exit;
   }
 
-  if (End - Buffer >= 200) {
-    Scale = (End - Buffer) / 100;
+  ZeroMem (&Stats, sizeof (Stats));
+
+  if (ulLength >= 200) {
+    Scale = ulLength / 100;
   }
 
-  for ( ; Buffer < End; Buffer += ToUpdate, Offset += ToUpdate) {
-    ToUpdate = MIN ((UINT64)(End - Buffer), SectorSize);
-    Print (L"   \rUpdating, %d%%", 100 - (End - Buffer) / Scale);
-    Status = SpiFlashUpdateBlock (Offset, Align, ToUpdate, Buffer, TmpBuf, SectorSize);
+  for (Remaining = ulLength; Remaining > 0; Remaining -= ToUpdate) {
+    Align       = Offset & (UPDATE_BLOCK_SIZE - 1);
+    BlockOffset = Offset - Align;
+    ToUpdate    = MIN (Remaining, UPDATE_BLOCK_SIZE - Align);
+
+    Print (L"   \rUpdating, %d%%", 100 - Remaining / Scale);
 
+    Status = HAL_SNOR_ReadData (g_nor, BlockOffset, OldBuf, UPDATE_BLOCK_SIZE);
+    if (Status != UPDATE_BLOCK_SIZE) {
+      DEBUG ((DEBUG_ERROR, "SpiFlash: Update: Error while reading old data\n"));
+      Status = EFI_DEVICE_ERROR;
+      break;
+    }
+
+    CopyMem (NewBuf, OldBuf, UPDATE_BLOCK_SIZE);
+    CopyMem (&NewBuf[Align], Buffer, ToUpdate);
+
+    Status = SpiFlashUpdateBlock (BlockOffset, OldBuf, NewBuf, &Stats);
     if (EFI_ERROR (Status)) {
       DEBUG ((DEBUG_ERROR, "SpiFlash: Error while updating\n"));
       break;
     }
+
+    Buffer += ToUpdate;
+    Offset += ToUpdate;
   }
 
   Print (L"\n");
-  FreePool (TmpBuf);
+  Print (
+    L"Block erases: %u, sector erases: %u, pages programmed: %u, sectors skipped: %u\n",
+    Stats.BlockErases,
+    Stats.SectorErases,
+    Stats.PagesProgrammed,
+    Stats.SectorsSkipped
+    );
+  DEBUG ((
+    DEBUG_INFO,
+    "SpiFlash: Update: %u block erases, %u sector erases, %u pages programmed, %u sectors skipped\n",
+    Stats.BlockErases,
+    Stats.SectorErases,
+    Stats.PagesProgrammed,
+    Stats.SectorsSkipped
+    ));
+
+Exit:
+  if (OldBuf != NULL) {
+    FreePool (OldBuf);
+  }
+
+  if (NewBuf != NULL) {
+    FreePool (NewBuf);
+  }
 
   return Status;
 }
@@ -1342,6 +1552,10 @@ NorVirtualNotifyEvent (
   IN VOID       *Context
   )
 {
+  // The DMA master cannot follow virtual addresses
+  g_nor->spi->dmaEnable = 0;
+  g_nor->bounceBuf      = NULL;
+
   // Convert SPI device description
   EfiConvertPointer (0, (VOID **)&g_nor->spi->instance);
   EfiConvertPointer (0, (VOID **)&g_nor->spi->CruBase);
@@ -1352,6 +1566,51 @@ NorVirtualNotifyEvent (
   return;
 }
 
+/**
+  Stop using DMA once the OS owns memory; the bounce buffer is boot services
+  data and runtime callers may pass buffers the DMA master cannot reach.
+
+  @param[in]    Event   The Event that is being processed
+  @param[in]    Context Event Context
+**/
+STATIC
+VOID
+EFIAPI
+NorExitBootServicesEvent (
+  IN EFI_EVENT  Event,
+  IN VOID       *Context
+  )
+{
+  g_nor->spi->dmaEnable = 0;
+  g_nor->bounceBuf      = NULL;
+}
+
+STATIC
+VOID
+NorAllocateBounceBuffer (
+  IN struct SPI_NOR  *Nor
+  )
+{
+  EFI_STATUS            Status;
+  EFI_PHYSICAL_ADDRESS  Address;
+
+  // The FSPI DMA address register is 32 bits wide
+  Address = MAX_UINT32;
+  Status  = gBS->AllocatePages (
+                   AllocateMaxAddress,
+                   EfiBootServicesData,
+                   EFI_SIZE_TO_PAGES (DMA_BOUNCE_SIZE),
+                   &Address
+                   );
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_WARN, "%a: No DMA bounce buffer, unaligned reads use PIO. Status=%r\n", __FUNCTION__, Status));
+    return;
+  }
+
+  Nor->bounceBuf  = (UINT8 *)(UINTN)Address;
+  Nor->bounceSize = DMA_BOUNCE_SIZE;
+}
+
 EFI_STATUS
 EFIAPI
 InitializeFlash (
@@ -1378,6 +1637,11 @@ InitializeFlash (
   g_nor->spi->mode |= (HAL_SPI_TX_QUAD | HAL_SPI_RX_QUAD);
   Status            = HAL_SNOR_Init (g_nor);
 
+  if (!EFI_ERROR (Status)) {
+    NorAllocateBounceBuffer (g_nor);
+    g_spi->dmaEnable = 1;
+  }
+
   Status = gBS->InstallProtocolInterface (
                   &ImageHandle,
                   &gUniNorFlashProtocolGuid,
@@ -1401,6 +1665,19 @@ InitializeFlash (
     goto ErrorSetMemAttr;
   }
 
+  Status = gBS->CreateEvent (
+                  EVT_SIGNAL_EXIT_BOOT_SERVICES,
+                  TPL_NOTIFY,
+                  NorExitBootServicesEvent,
+                  NULL,
+                  &mNorExitBootServicesEvent
+                  );
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "%a: Failed to register ExitBootServices event\n", __FUNCTION__));
+    gBS->CloseEvent (mNorVirtualAddrChangeEvent);
+    goto ErrorSetMemAttr;
+  }
+
   return Status;
 ErrorSetMemAttr:
   gBS->UninstallProtocolInterface (
@@ -283,6 +283,7 @@ OhciControlTransfer (
   ED_DESCRIPTOR    *HeadEd;
   ED_DESCRIPTOR    *Ed;
   TD_DESCRIPTOR    *HeadTd;
+  TD_DESCRIPTOR    *TailTd;
   TD_DESCRIPTOR    *SetupTd;
   TD_DESCRIPTOR    *DataTd;
   TD_DESCRIPTOR    *StatusTd;
@@ -290,7 +291,6 @@ OhciControlTransfer (
   EFI_STATUS       Status;
   UINT32           DataPidDir;
   UINT32           StatusPidDir;
-  UINTN            TimeCount;
   OHCI_ED_RESULT   EdResult;
 
   DMA_MAP_OPERATION  MapOp;
@@ -351,7 +351,16 @@ OhciControlTransfer (
     return EFI_DEVICE_ERROR;
   }
 
-  gBS->Stall (20 * 1000);
+  //
+  // The controller may still be walking the list until the end of the
+  // current frame. Wait for the next SOF before touching it.
+  //
+  Status = OhciWaitForNextFrame (Ohc);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "OhciControlTransfer: controller stopped generating frames\r\n"));
+    *TransferResult = EFI_USB_ERR_TIMEOUT;
+    return Status;
+  }
 
   OhciSetMemoryPointer (Ohc, HC_CONTROL_HEAD, NULL);
   Ed = OhciCreateED (Ohc);
@@ -395,6 +404,7 @@ OhciControlTransfer (
   }
 
   HeadTd = SetupTd;
+  TailTd = SetupTd;
   OhciSetTDField (SetupTd, TD_PDATA, 0);
   OhciSetTDField (SetupTd, TD_BUFFER_ROUND, 1);
   OhciSetTDField (SetupTd, TD_DIR_PID, TD_SETUP_PID);
@@ -431,10 +441,7 @@ OhciControlTransfer (
   ActualSendLength = DataMapLength;
   DataToggle       = 1;
   while (LeftLength > 0) {
-    ActualSendLength = LeftLength;
-    if (LeftLength > MaxPacketLength) {
-      ActualSendLength = MaxPacketLength;
-    }
+    ActualSendLength = OhciGetTDTransferLength (DataMapPhyAddr, LeftLength, MaxPacketLength);
 
     DataTd = OhciCreateTD (Ohc);
     if (DataTd == NULL) {
@@ -456,8 +463,12 @@ OhciControlTransfer (
     DataTd->ActualSendLength = (UINT32)ActualSendLength;
     DataTd->DataBuffer       = (UINT32)DataMapPhyAddr;
     DataTd->NextTDPointer    = 0;
-    OhciLinkTD (HeadTd, DataTd);
-    DataToggle     ^= 1;
+    OhciLinkTD (TailTd, DataTd);
+    TailTd = DataTd;
+    //
+    // The controller toggles once per packet within the TD.
+    //
+    DataToggle     ^= (UINT8)(((ActualSendLength + MaxPacketLength - 1) / MaxPacketLength) & 1);
     DataMapPhyAddr += ActualSendLength;
     LeftLength     -= ActualSendLength;
   }
@@ -485,7 +496,8 @@ OhciControlTransfer (
   StatusTd->ActualSendLength = 0;
   StatusTd->DataBuffer       = 0;
   StatusTd->NextTDPointer    = 0;
-  OhciLinkTD (HeadTd, StatusTd);
+  OhciLinkTD (TailTd, StatusTd);
+  TailTd = StatusTd;
   //
   // Empty Stage
   //
@@ -509,7 +521,7 @@ OhciControlTransfer (
   EmptyTd->ActualSendLength = 0;
   EmptyTd->DataBuffer       = 0;
   EmptyTd->NextTDPointer    = 0;
-  OhciLinkTD (HeadTd, EmptyTd);
+  OhciLinkTD (TailTd, EmptyTd);
   Ed->TdTailPointer = (UINT32)(UINTN)EmptyTd;
   OhciAttachTDListToED (Ed, HeadTd);
   //
@@ -535,16 +547,7 @@ OhciControlTransfer (
     goto UNMAP_DATA_BUFF;
   }
 
-  gBS->Stall (20 * 1000);
-
-  TimeCount = 0;
-  Status    = CheckIfDone (Ohc, CONTROL_LIST, Ed, HeadTd, &EdResult);
-
-  while (Status == EFI_NOT_READY && TimeCount <= TimeOut) {
-    gBS->Stall (1000);
-    TimeCount++;
-    Status = CheckIfDone (Ohc, CONTROL_LIST, Ed, HeadTd, &EdResult);
-  }
+  Status = OhciWaitForTransfer (Ohc, CONTROL_LIST, Ed, HeadTd, TimeOut, &EdResult);
 
   //
   // For debugging, dump ED & TD buffer after transferring
@@ -653,11 +656,11 @@ OhciBulkTransfer (
   ED_DESCRIPTOR    *Ed;
   UINT32           DataPidDir;
   TD_DESCRIPTOR    *HeadTd;
+  TD_DESCRIPTOR    *TailTd;
   TD_DESCRIPTOR    *DataTd;
   TD_DESCRIPTOR    *EmptyTd;
   EFI_STATUS       Status;
   UINT8            EndPointNum;
-  UINTN            TimeCount;
   OHCI_ED_RESULT   EdResult;
 
   DMA_MAP_OPERATION     MapOp;
@@ -709,7 +712,16 @@ OhciBulkTransfer (
     return EFI_DEVICE_ERROR;
   }
 
-  gBS->Stall (20 * 1000);
+  //
+  // The controller may still be walking the list until the end of the
+  // current frame. Wait for the next SOF before touching it.
+  //
+  Status = OhciWaitForNextFrame (Ohc);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "OhciBulkTransfer: controller stopped generating frames\r\n"));
+    *TransferResult = EFI_USB_ERR_TIMEOUT;
+    return Status;
+  }
 
   OhciSetMemoryPointer (Ohc, HC_BULK_HEAD, NULL);
 
@@ -747,12 +759,10 @@ OhciBulkTransfer (
   LeftLength       = MapLength;
   ActualSendLength = MapLength;
   HeadTd           = NULL;
+  TailTd           = NULL;
   FirstTD          = TRUE;
   while (LeftLength > 0) {
-    ActualSendLength = LeftLength;
-    if (LeftLength > MaxPacketLength) {
-      ActualSendLength = MaxPacketLength;
-    }
+    ActualSendLength = OhciGetTDTransferLength (MapPyhAddr, LeftLength, MaxPacketLength);
 
     DataTd = OhciCreateTD (Ohc);
     if (DataTd == NULL) {
@@ -778,10 +788,15 @@ OhciBulkTransfer (
       HeadTd  = DataTd;
       FirstTD = FALSE;
     } else {
-      OhciLinkTD (HeadTd, DataTd);
+      OhciLinkTD (TailTd, DataTd);
     }
 
-    *DataToggle ^= 1;
+    TailTd = DataTd;
+
+    //
+    // The controller toggles once per packet within the TD.
+    //
+    *DataToggle ^= (UINT8)(((ActualSendLength + MaxPacketLength - 1) / MaxPacketLength) & 1);
     MapPyhAddr  += ActualSendLength;
     LeftLength  -= ActualSendLength;
   }
@@ -810,7 +825,7 @@ OhciBulkTransfer (
   EmptyTd->ActualSendLength = 0;
   EmptyTd->DataBuffer       = 0;
   EmptyTd->NextTDPointer    = 0;
-  OhciLinkTD (HeadTd, EmptyTd);
+  OhciLinkTD (TailTd, EmptyTd);
   Ed->TdTailPointer = (UINT32)(UINTN)EmptyTd;
   OhciAttachTDListToED (Ed, HeadTd);
 
@@ -831,15 +846,7 @@ OhciBulkTransfer (
     goto FREE_OHCI_TDBUFF;
   }
 
-  gBS->Stall (20 * 1000);
-
-  TimeCount = 0;
-  Status    = CheckIfDone (Ohc, BULK_LIST, Ed, HeadTd, &EdResult);
-  while (Status == EFI_NOT_READY && TimeCount <= TimeOut) {
-    gBS->Stall (1000);
-    TimeCount++;
-    Status = CheckIfDone (Ohc, BULK_LIST, Ed, HeadTd, &EdResult);
-  }
+  Status = OhciWaitForTransfer (Ohc, BULK_LIST, Ed, HeadTd, TimeOut, &EdResult);
 
   *TransferResult = ConvertErrorCode (EdResult.ErrorCode);
 
@@ -2111,6 +2118,8 @@ OhciCleanDevUp (
   This->Reset (This, EFI_USB_HC_RESET_GLOBAL);
   This->SetState (This, EfiUsbHcStateHalt);
 
+  OhciDumpLatencyHistogram (Ohc);
+
   //
   // Free resources
   //
@@ -2142,6 +2151,9 @@ OhcExitBootService (
   Ohc = (USB_OHCI_HC_DEV *)Context;
 
   UsbHc = &Ohc->UsbHc;
+
+  OhciDumpLatencyHistogram (Ohc);
+
   //
   // Stop the Host Controller
   //
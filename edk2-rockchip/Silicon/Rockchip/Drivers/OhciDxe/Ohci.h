@@ -46,6 +46,12 @@ extern EFI_COMPONENT_NAME2_PROTOCOL  gOhciComponentName2;
 
 #define USB_OHCI_HC_DEV_SIGNATURE  SIGNATURE_32('o','h','c','i')
 
+//
+// Control/bulk transfer latency histogram buckets, in microseconds.
+// The last bucket holds everything slower than the previous one.
+//
+#define OHCI_LATENCY_BUCKETS  10
+
 typedef struct _HCCA_MEMORY_BLOCK {
   UINT32    HccaInterruptTable[32];                    // 32-bit Physical Address to ED_DESCRIPTOR
   UINT16    HccaFrameNumber;
@@ -85,6 +91,9 @@ struct _USB_OHCI_HC_DEV {
   EFI_UNICODE_STRING_TABLE    *ControllerNameTable;
 
   OHCI_DEVICE_PROTOCOL        *Protocol;
+
+  UINT32                      TransferLatency[OHCI_LATENCY_BUCKETS];
+  UINT32                      TransferTimeouts;
 };
 
 #define USB_OHCI_HC_DEV_FROM_THIS(a)  CR(a, USB_OHCI_HC_DEV, UsbHc, USB_OHCI_HC_DEV_SIGNATURE)
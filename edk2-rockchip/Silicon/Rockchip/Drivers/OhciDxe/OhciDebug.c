@@ -88,3 +88,63 @@ OhciDumpReg (
     DEBUG ((DEBUG_INFO, "OhcDumpReg 0x%x = 0x%x\n", Ohc->UsbHcBaseAddress +0x04*i, Data));
   }
 }
+
+STATIC CONST UINT32  mOhciLatencyBucketLimit[OHCI_LATENCY_BUCKETS - 1] = {
+  50, 100, 250, 500, 1000, 2000, 5000, 10000, 50000
+};
+
+/*++
+
+  Account a completed control or bulk transfer in the latency histogram
+
+  @param  Ohc                   Pointer to OHCI private data
+  @param  Latency               Transfer latency in microseconds
+  @param  TimedOut              TRUE if the transfer did not complete in time
+
+**/
+VOID
+OhciRecordTransferLatency (
+  IN USB_OHCI_HC_DEV  *Ohc,
+  IN UINTN            Latency,
+  IN BOOLEAN          TimedOut
+  )
+{
+  UINTN  Index;
+
+  if (TimedOut) {
+    Ohc->TransferTimeouts++;
+    return;
+  }
+
+  for (Index = 0; Index < OHCI_LATENCY_BUCKETS - 1; Index++) {
+    if (Latency < mOhciLatencyBucketLimit[Index]) {
+      break;
+    }
+  }
+
+  Ohc->TransferLatency[Index]++;
+}
+
+/*++
+
+  Print the control and bulk transfer latency histogram
+
+  @param  Ohc                   Pointer to OHCI private data
+
+**/
+VOID
+OhciDumpLatencyHistogram (
+  IN USB_OHCI_HC_DEV  *Ohc
+  )
+{
+  UINTN  Index;
+
+  DEBUG ((DEBUG_INFO, "OHCI 0x%x transfer latency:\n", Ohc->UsbHcBaseAddress));
+
+  for (Index = 0; Index < OHCI_LATENCY_BUCKETS - 1; Index++) {
+    DEBUG ((DEBUG_INFO, "  < %6d uS: %d\n", mOhciLatencyBucketLimit[Index], Ohc->TransferLatency[Index]));
+  }
+
+  DEBUG ((DEBUG_INFO, "  >=%6d uS: %d\n", mOhciLatencyBucketLimit[Index - 1], Ohc->TransferLatency[Index]));
+  DEBUG ((DEBUG_INFO, "  timed out : %d\n", Ohc->TransferTimeouts));
+}
@@ -41,3 +41,31 @@ VOID
 OhciDumpReg (
   IN USB_OHCI_HC_DEV  *Ohc
   );
+
+/*++
+
+  Account a completed control or bulk transfer in the latency histogram
+
+  @param  Ohc                   Pointer to OHCI private data
+  @param  Latency               Transfer latency in microseconds
+  @param  TimedOut              TRUE if the transfer did not complete in time
+
+**/
+VOID
+OhciRecordTransferLatency (
+  IN USB_OHCI_HC_DEV  *Ohc,
+  IN UINTN            Latency,
+  IN BOOLEAN          TimedOut
+  );
+
+/*++
+
+  Print the control and bulk transfer latency histogram
+
+  @param  Ohc                   Pointer to OHCI private data
+
+**/
+VOID
+OhciDumpLatencyHistogram (
+  IN USB_OHCI_HC_DEV  *Ohc
+  );
@@ -115,6 +115,7 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 #define ONE_SECOND                 1000000
 #define ONE_MILLI_SEC              1000
 #define MAX_BYTES_PER_TD           0x1000
+#define TD_PAGE_SIZE               0x1000
 #define MAX_RETRY_TIMES            100
 #define PORT_NUMBER_ON_MAINSTONE2  1
 
@@ -339,6 +339,90 @@ CheckIfDone (
   }
 }
 
+/**
+
+  Wait for the host controller to start a new frame. Once this returns,
+  the controller no longer holds references to lists that were disabled
+  before the call.
+
+  @Param  Ohc                   UHC private data
+
+  @retval  EFI_SUCCESS          A new frame has started
+  @retval  EFI_TIMEOUT          No SOF was seen within OHCI_FRAME_WAIT_TIMEOUT
+
+**/
+EFI_STATUS
+OhciWaitForNextFrame (
+  IN  USB_OHCI_HC_DEV  *Ohc
+  )
+{
+  UINTN  Elapsed;
+
+  OhciClearInterruptStatus (Ohc, START_OF_FRAME);
+
+  for (Elapsed = 0; Elapsed < OHCI_FRAME_WAIT_TIMEOUT; Elapsed += OHCI_TRANSFER_POLL_INTERVAL) {
+    if (OhciGetHcInterruptStatus (Ohc, START_OF_FRAME) != 0) {
+      OhciClearInterruptStatus (Ohc, START_OF_FRAME);
+      return EFI_SUCCESS;
+    }
+
+    gBS->Stall (OHCI_TRANSFER_POLL_INTERVAL);
+  }
+
+  DEBUG ((DEBUG_WARN, "OhciWaitForNextFrame: no SOF within %d uS\r\n", OHCI_FRAME_WAIT_TIMEOUT));
+  return EFI_TIMEOUT;
+}
+
+/**
+
+  Poll a control or bulk task until it completes, fails or times out,
+  and record its latency.
+
+  @Param  Ohc                   UHC private data
+  @Param  ListType              Pipe type
+  @Param  Ed                    Pointer to the ED task hooked on
+  @Param  HeadTd                Head of TD corresponding to the task
+  @Param  TimeOut               Time out value in milliseconds
+  @Param  EdResult              return the ErrorCode and next toggle
+
+  @retval  EFI_SUCCESS          Task done
+  @retval  EFI_NOT_READY        Task still on processing after TimeOut
+  @retval  EFI_DEVICE_ERROR     Some error occured
+
+**/
+EFI_STATUS
+OhciWaitForTransfer (
+  IN  USB_OHCI_HC_DEV       *Ohc,
+  IN  DESCRIPTOR_LIST_TYPE  ListType,
+  IN  ED_DESCRIPTOR         *Ed,
+  IN  TD_DESCRIPTOR         *HeadTd,
+  IN  UINTN                 TimeOut,
+  OUT OHCI_ED_RESULT        *EdResult
+  )
+{
+  EFI_STATUS  Status;
+  UINTN       Elapsed;
+  UINTN       Limit;
+
+  //
+  // Elapsed is the time spent stalling, in microseconds. It is
+  // accurate enough for both the timeout and the histogram.
+  //
+  Elapsed = 0;
+  Limit   = MAX (TimeOut, 1) * 1000;
+
+  Status = CheckIfDone (Ohc, ListType, Ed, HeadTd, EdResult);
+  while (Status == EFI_NOT_READY && Elapsed < Limit) {
+    gBS->Stall (OHCI_TRANSFER_POLL_INTERVAL);
+    Elapsed += OHCI_TRANSFER_POLL_INTERVAL;
+    Status   = CheckIfDone (Ohc, ListType, Ed, HeadTd, EdResult);
+  }
+
+  OhciRecordTransferLatency (Ohc, Elapsed, Status == EFI_NOT_READY);
+
+  return Status;
+}
+
 /**
 
   Convert TD condition code to Efi Status
@@ -16,6 +16,17 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 #define GRID_SIZE      16
 #define GRID_SHIFT     4
 
+//
+// Control and bulk transfers are polled for completion every
+// OHCI_TRANSFER_POLL_INTERVAL microseconds.
+//
+#define OHCI_TRANSFER_POLL_INTERVAL  10
+
+//
+// A new frame starts every millisecond, allow for some slack.
+//
+#define OHCI_FRAME_WAIT_TIMEOUT  2000
+
 typedef struct _INTERRUPT_CONTEXT_ENTRY INTERRUPT_CONTEXT_ENTRY;
 
 struct _INTERRUPT_CONTEXT_ENTRY {
@@ -170,6 +181,50 @@ CheckIfDone (
   OUT OHCI_ED_RESULT        *EdResult
   );
 
+/**
+
+  Wait for the host controller to start a new frame. Once this returns,
+  the controller no longer holds references to lists that were disabled
+  before the call.
+
+  @Param  Ohc                   UHC private data
+
+  @retval  EFI_SUCCESS          A new frame has started
+  @retval  EFI_TIMEOUT          No SOF was seen within OHCI_FRAME_WAIT_TIMEOUT
+
+**/
+EFI_STATUS
+OhciWaitForNextFrame (
+  IN  USB_OHCI_HC_DEV  *Ohc
+  );
+
+/**
+
+  Poll a control or bulk task until it completes, fails or times out,
+  and record its latency.
+
+  @Param  Ohc                   UHC private data
+  @Param  ListType              Pipe type
+  @Param  Ed                    Pointer to the ED task hooked on
+  @Param  HeadTd                Head of TD corresponding to the task
+  @Param  TimeOut               Time out value in milliseconds
+  @Param  EdResult              return the ErrorCode and next toggle
+
+  @retval  EFI_SUCCESS          Task done
+  @retval  EFI_NOT_READY        Task still on processing after TimeOut
+  @retval  EFI_DEVICE_ERROR     Some error occured
+
+**/
+EFI_STATUS
+OhciWaitForTransfer (
+  IN  USB_OHCI_HC_DEV       *Ohc,
+  IN  DESCRIPTOR_LIST_TYPE  ListType,
+  IN  ED_DESCRIPTOR         *Ed,
+  IN  TD_DESCRIPTOR         *HeadTd,
+  IN  UINTN                 TimeOut,
+  OUT OHCI_ED_RESULT        *EdResult
+  );
+
 /**
 
   Convert TD condition code to Efi Status
@@ -496,6 +496,38 @@ OhciFreeInterruptEdByAddr (
   return EFI_SUCCESS;
 }
 
+/**
+
+  Compute how much of a buffer a single general TD can describe.
+
+  A general TD may span two physical pages, i.e. cross at most one
+  4K boundary. Unless it is the last one, a TD must also end on a
+  packet boundary so that no packet is split across two TDs.
+
+  @Param  PhyAddr               Bus address of the remaining buffer
+  @Param  LeftLength            Bytes left to transfer
+  @Param  MaxPacketLength       Max packet size of the endpoint
+
+  @retval                       Number of bytes for the TD
+
+**/
+UINTN
+OhciGetTDTransferLength (
+  IN EFI_PHYSICAL_ADDRESS  PhyAddr,
+  IN UINTN                 LeftLength,
+  IN UINTN                 MaxPacketLength
+  )
+{
+  UINTN  Length;
+
+  Length = 2 * TD_PAGE_SIZE - (UINTN)(PhyAddr & (TD_PAGE_SIZE - 1));
+  if (LeftLength <= Length) {
+    return LeftLength;
+  }
+
+  return Length - (Length % MaxPacketLength);
+}
+
 /**
 
   Link Td2 to the end of Td1
@@ -232,6 +232,24 @@ OhciFreeInterruptEdByAddr (
   IN UINT8            EndPointNum
   );
 
+/**
+
+  Compute how much of a buffer a single general TD can describe.
+
+  @Param  PhyAddr               Bus address of the remaining buffer
+  @Param  LeftLength            Bytes left to transfer
+  @Param  MaxPacketLength       Max packet size of the endpoint
+
+  @retval                       Number of bytes for the TD
+
+**/
+UINTN
+OhciGetTDTransferLength (
+  IN EFI_PHYSICAL_ADDRESS  PhyAddr,
+  IN UINTN                 LeftLength,
+  IN UINTN                 MaxPacketLength
+  );
+
 /**
 
   Link Td2 to the end of Td1
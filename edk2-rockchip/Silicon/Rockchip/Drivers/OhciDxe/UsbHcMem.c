@@ -334,6 +334,8 @@ UsbHcInitMemPool (
   )
 {
   USBHC_MEM_POOL  *Pool;
+  VOID            *Mem;
+  UINTN           Index;
 
   Pool = AllocatePool (sizeof (USBHC_MEM_POOL));
 
@@ -341,13 +343,34 @@ UsbHcInitMemPool (
     return Pool;
   }
 
-  Pool->Check4G = Check4G;
-  Pool->Which4G = Which4G;
-  Pool->Head    = UsbHcAllocMemBlock (Pool, USBHC_MEM_DEFAULT_PAGES);
+  Pool->FreeUnits = AllocatePool (USBHC_MEM_CACHED_UNITS * sizeof (VOID *));
+
+  if (Pool->FreeUnits == NULL) {
+    gBS->FreePool (Pool);
+    return NULL;
+  }
+
+  Pool->Check4G       = Check4G;
+  Pool->Which4G       = Which4G;
+  Pool->FreeUnitCount = 0;
+  Pool->Head          = UsbHcAllocMemBlock (Pool, USBHC_MEM_DEFAULT_PAGES);
 
   if (Pool->Head == NULL) {
+    gBS->FreePool (Pool->FreeUnits);
     gBS->FreePool (Pool);
-    Pool = NULL;
+    return NULL;
+  }
+
+  //
+  // Carve out enough TDs and EDs up front for a large bulk transfer.
+  //
+  for (Index = 0; Index < USBHC_MEM_PREALLOC_UNITS; Index++) {
+    Mem = UsbHcAllocMemFromBlock (Pool->Head, 1);
+    if (Mem == NULL) {
+      break;
+    }
+
+    Pool->FreeUnits[Pool->FreeUnitCount++] = Mem;
   }
 
   return Pool;
@@ -382,6 +405,7 @@ UsbHcFreeMemPool (
   }
 
   UsbHcFreeMemBlock (Pool, Pool->Head);
+  gBS->FreePool (Pool->FreeUnits);
   gBS->FreePool (Pool);
   return EFI_SUCCESS;
 }
@@ -414,6 +438,12 @@ UsbHcAllocateMem (
   Head      = Pool->Head;
   ASSERT (Head != NULL);
 
+  if ((AllocSize == USBHC_MEM_UNIT) && (Pool->FreeUnitCount > 0)) {
+    Mem = Pool->FreeUnits[--Pool->FreeUnitCount];
+    ZeroMem (Mem, Size);
+    return Mem;
+  }
+
   //
   // First check whether current memory blocks can satisfy the allocation.
   //
@@ -489,6 +519,11 @@ UsbHcFreeMem (
   AllocSize = USBHC_MEM_ROUND (Size);
   ToFree    = (UINT8 *)Mem;
 
+  if ((AllocSize == USBHC_MEM_UNIT) && (Pool->FreeUnitCount < USBHC_MEM_CACHED_UNITS)) {
+    Pool->FreeUnits[Pool->FreeUnitCount++] = Mem;
+    return;
+  }
+
   for (Block = Head; Block != NULL; Block = Block->Next) {
     //
     // scan the memory block list for the memory block that
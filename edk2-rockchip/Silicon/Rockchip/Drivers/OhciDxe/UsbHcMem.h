@@ -39,6 +39,14 @@ typedef struct _USBHC_MEM_POOL {
   BOOLEAN            Check4G;
   UINT32             Which4G;
   USBHC_MEM_BLOCK    *Head;
+  //
+  // Single unit allocations (TDs and EDs) are recycled through
+  // this stack instead of going back to the block bitmaps. It is
+  // kept outside the units, as the host controller may still fetch
+  // a freed TD or ED until the next SOF.
+  //
+  VOID               **FreeUnits;
+  UINTN              FreeUnitCount;
 } USBHC_MEM_POOL;
 
 //
@@ -51,6 +59,13 @@ typedef struct _USBHC_MEM_POOL {
 
 #define USBHC_MEM_ROUND(Len)  (((Len) + USBHC_MEM_UNIT_MASK) & (~USBHC_MEM_UNIT_MASK))
 
+//
+// Number of single units put on the free list when the pool is created,
+// and the maximum number of units the free list may hold.
+//
+#define USBHC_MEM_PREALLOC_UNITS  128
+#define USBHC_MEM_CACHED_UNITS    512
+
 //
 // Advance the byte and bit to the next bit, adjust byte accordingly.
 //
@@ -39,6 +39,8 @@
 #include <IndustryStandard/SmBios.h>
 #include <Protocol/Smbios.h>
 #include <Guid/SmBios.h>
+#include <Guid/DramInfoTable.h>
+#include <Guid/EventGroup.h>
 #include <Library/ArmLib.h>
 #include <Library/DebugLib.h>
 #include <Library/UefiDriverEntryPoint.h>
@@ -59,7 +61,12 @@
 
 #define SMB_IS_DIGIT(c)  (((c) >= '0') && ((c) <= '9'))
 
-STATIC UINT64  mMemorySize = 0;
+STATIC UINT64      mMemorySize = 0;
+STATIC SDRAM_INFO  mSdramInfo;
+STATIC BOOLEAN     mSdramInfoValid = FALSE;
+STATIC UINT32      mMemoryDataRate = 0;
+STATIC EFI_EVENT   mDramInfoTableEvent;
+STATIC EFI_EVENT   mEndOfDxeEvent;
 
 UINT32
 EFIAPI
@@ -535,6 +542,7 @@ CHAR8                *mPhyMemArrayInfoType16Strings[] = {
 /***********************************************************************
         SMBIOS data definition  TYPE17  Memory Device Information
 ************************************************************************/
+CHAR8  mMemDevInfoLocator[16] = "SDRAM";
 CHAR8  mMemDevInfoVendor[128];
 
 SMBIOS_TABLE_TYPE17  mMemDevInfoType17 = {
@@ -605,7 +613,7 @@ SMBIOS_TABLE_TYPE17  mMemDevInfoType17 = {
   0                      // ExtendedConfiguredMemorySpeed
 };
 CHAR8                *mMemDevInfoType17Strings[] = {
-  "SDRAM",
+  mMemDevInfoLocator,
   mMemDevInfoVendor,
   NULL
 };
@@ -1000,6 +1008,34 @@ ProcessorGetRate (
   return (UINT32)Rate;
 }
 
+STATIC MEMORY_DEVICE_TYPE
+MemoryGetDeviceType (
+  IN UINT32  DdrType
+  )
+{
+  switch (DdrType) {
+    case SDRAM_DDR2:
+      return MemoryTypeDdr2;
+    case SDRAM_DDR3:
+      return MemoryTypeDdr3;
+    case SDRAM_DDR4:
+      return MemoryTypeDdr4;
+    case SDRAM_DDR5:
+      return MemoryTypeDdr5;
+    case SDRAM_LPDDR2:
+      return MemoryTypeLpddr2;
+    case SDRAM_LPDDR3:
+      return MemoryTypeLpddr3;
+    case SDRAM_LPDDR4:
+    case SDRAM_LPDDR4X:
+      return MemoryTypeLpddr4;
+    case SDRAM_LPDDR5:
+      return MemoryTypeLpddr5;
+    default:
+      return MemoryTypeUnknown;
+  }
+}
+
 /***********************************************************************
         SMBIOS data update  TYPE4  Processor Information
 ************************************************************************/
@@ -1098,6 +1134,10 @@ PhyMemArrayInfoUpdateSmbiosType16 (
   mPhyMemArrayInfoType16.MaximumCapacity = mMemDevInfoType17.Size * 1024;                    // Size in KB
   mMemDevInfoType17.VolatileSize         = MultU64x32 (mMemDevInfoType17.Size, 1024 * 1024); // Size in Bytes
 
+  if (mSdramInfoValid) {
+    mPhyMemArrayInfoType16.NumberOfMemoryDevices = (UINT16)mSdramInfo.ChannelCount;
+  }
+
   LogSmbiosData ((EFI_SMBIOS_TABLE_HEADER *)&mPhyMemArrayInfoType16, mPhyMemArrayInfoType16Strings, &MemArraySmbiosHandle);
 
   //
@@ -1115,9 +1155,41 @@ MemDevInfoUpdateSmbiosType17 (
   VOID
   )
 {
+  UINT32              Index;
+  UINT32              DataRate;
+  SDRAM_CHANNEL_INFO  *Channel;
+
   AsciiStrCpyS (mMemDevInfoVendor, sizeof (mMemDevInfoVendor), (CHAR8 *)PcdGetPtr (PcdMemoryVendorName));
 
-  LogSmbiosData ((EFI_SMBIOS_TABLE_HEADER *)&mMemDevInfoType17, mMemDevInfoType17Strings, NULL);
+  if (!mSdramInfoValid) {
+    LogSmbiosData ((EFI_SMBIOS_TABLE_HEADER *)&mMemDevInfoType17, mMemDevInfoType17Strings, NULL);
+    return;
+  }
+
+  //
+  // One device per DRAM channel.
+  //
+  DataRate = mMemoryDataRate;
+
+  mMemDevInfoType17.MemoryType                 = MemoryGetDeviceType (mSdramInfo.DdrType);
+  mMemDevInfoType17.TypeDetail.Unknown         = 0;
+  mMemDevInfoType17.TypeDetail.Synchronous     = 1;
+  mMemDevInfoType17.Speed                      = (UINT16)DataRate;
+  mMemDevInfoType17.ConfiguredMemoryClockSpeed = (UINT16)DataRate;
+
+  for (Index = 0; Index < mSdramInfo.ChannelCount; Index++) {
+    Channel = &mSdramInfo.Channels[Index];
+
+    mMemDevInfoType17.Size         = (UINT16)Channel->SizeMb;
+    mMemDevInfoType17.VolatileSize = MultU64x32 (Channel->SizeMb, 1024 * 1024);
+    mMemDevInfoType17.TotalWidth   = Channel->BusWidth;
+    mMemDevInfoType17.DataWidth    = Channel->BusWidth;
+    mMemDevInfoType17.Attributes   = Channel->Ranks;
+
+    AsciiSPrint (mMemDevInfoLocator, sizeof (mMemDevInfoLocator), "SDRAM CH%u", Index);
+
+    LogSmbiosData ((EFI_SMBIOS_TABLE_HEADER *)&mMemDevInfoType17, mMemDevInfoType17Strings, NULL);
+  }
 }
 
 /***********************************************************************
@@ -1148,6 +1220,43 @@ BootInfoUpdateSmbiosType32 (
   LogSmbiosData ((EFI_SMBIOS_TABLE_HEADER *)&mBootInfoType32, mBootInfoType32Strings, NULL);
 }
 
+/***********************************************************************
+        SMBIOS data update  TYPE16, TYPE17 and TYPE19  Memory Information
+************************************************************************/
+STATIC
+VOID
+EFIAPI
+OnMemoryInfoReady (
+  IN EFI_EVENT  Event,
+  IN VOID       *Context
+  )
+{
+  EFI_STATUS       Status;
+  DRAM_INFO_TABLE  *DramInfo;
+
+  gBS->CloseEvent (mDramInfoTableEvent);
+  gBS->CloseEvent (mEndOfDxeEvent);
+
+  Status = EfiGetSystemConfigurationTable (&gRockchipDramInfoTableGuid, (VOID **)&DramInfo);
+  if (!EFI_ERROR (Status)) {
+    CopyMem (&mSdramInfo, &DramInfo->Sdram, sizeof (mSdramInfo));
+    mMemoryDataRate = DramInfo->DataRate;
+    mSdramInfoValid = TRUE;
+  } else {
+    //
+    // No platform table by the end of DXE, decode the topology directly.
+    // The data rate stays unknown.
+    //
+    mSdramInfoValid = !RETURN_ERROR (SdramGetInfo (&mSdramInfo));
+  }
+
+  PhyMemArrayInfoUpdateSmbiosType16 ();
+
+  MemDevInfoUpdateSmbiosType17 ();
+
+  MemArrMapInfoUpdateSmbiosType19 ();
+}
+
 /***********************************************************************
         Driver Entry
 ************************************************************************/
@@ -1158,6 +1267,9 @@ PlatformSmbiosDriverEntryPoint (
   IN EFI_SYSTEM_TABLE  *SystemTable
   )
 {
+  EFI_STATUS  Status;
+  VOID        *DramInfo;
+
   DEBUG ((DEBUG_INFO, "PlatformSmbiosDriverEntryPoint() called\n"));
 
   mMemorySize = SdramGetMemorySize ();
@@ -1178,13 +1290,35 @@ PlatformSmbiosDriverEntryPoint (
 
   OemStringsUpdateSmbiosType11 ();
 
-  PhyMemArrayInfoUpdateSmbiosType16 ();
+  BootInfoUpdateSmbiosType32 ();
 
-  MemDevInfoUpdateSmbiosType17 ();
+  //
+  // The memory tables are added once the platform has published the DRAM
+  // info table, which may happen after this driver has been dispatched.
+  //
+  Status = gBS->CreateEventEx (
+                  EVT_NOTIFY_SIGNAL,
+                  TPL_CALLBACK,
+                  OnMemoryInfoReady,
+                  NULL,
+                  &gRockchipDramInfoTableGuid,
+                  &mDramInfoTableEvent
+                  );
+  ASSERT_EFI_ERROR (Status);
 
-  MemArrMapInfoUpdateSmbiosType19 ();
+  Status = gBS->CreateEventEx (
+                  EVT_NOTIFY_SIGNAL,
+                  TPL_CALLBACK,
+                  OnMemoryInfoReady,
+                  NULL,
+                  &gEfiEndOfDxeEventGroupGuid,
+                  &mEndOfDxeEvent
+                  );
+  ASSERT_EFI_ERROR (Status);
 
-  BootInfoUpdateSmbiosType32 ();
+  if (!EFI_ERROR (EfiGetSystemConfigurationTable (&gRockchipDramInfoTableGuid, &DramInfo))) {
+    gBS->SignalEvent (mDramInfoTableEvent);
+  }
 
   DEBUG ((DEBUG_INFO, "PlatformSmbiosDriverEntryPoint() returning\n"));
 
@@ -56,6 +56,7 @@ STATIC CONST FVB_DEVICE  mRkFvbFlashInstanceTemplate = {
   NULL,  // DiskDevice ... NEED TO BE FILLED
   0,     // DiskMediaId ... NEED TO BE FILLED
   FALSE, // DiskDataInvalidated ... NEED TO BE FILLED
+  NULL,  // DiskDirtyBlocks ... NEED TO BE FILLED
 
   NULL, // Handle ... NEED TO BE FILLED
 
@@ -675,6 +676,42 @@ FvbRead (
   return EFI_SUCCESS;
 }
 
+/**
+  Record that a range of the shadow buffer no longer matches the disk copy.
+
+  @param FlashInstance   The FVB device.
+  @param Lba             The logical block the range starts in.
+  @param Offset          Offset into the block.
+  @param NumBytes        Size of the range.
+**/
+STATIC
+VOID
+FvbMarkDiskDataDirty (
+  IN FVB_DEVICE  *FlashInstance,
+  IN EFI_LBA     Lba,
+  IN UINTN       Offset,
+  IN UINTN       NumBytes
+  )
+{
+  UINTN  Block;
+  UINTN  LastBlock;
+  UINTN  NumBlocks;
+
+  FlashInstance->DiskDataInvalidated = TRUE;
+
+  if ((FlashInstance->DiskDirtyBlocks == NULL) || (NumBytes == 0)) {
+    return;
+  }
+
+  NumBlocks = FlashInstance->FvbSize / FlashInstance->Media.BlockSize;
+  Block     = (UINTN)Lba + Offset / FlashInstance->Media.BlockSize;
+  LastBlock = (UINTN)Lba + (Offset + NumBytes - 1) / FlashInstance->Media.BlockSize;
+
+  for ( ; Block <= LastBlock && Block < NumBlocks; Block++) {
+    FlashInstance->DiskDirtyBlocks[Block / 8] |= (UINT8)(1 << (Block % 8));
+  }
+}
+
 /**
  Writes the specified number of bytes from the input buffer to the block.
 
@@ -778,7 +815,7 @@ FvbWrite (
   CopyMem ((UINTN *)DataOffset, Buffer, *NumBytes);
 
   // Must sync the data if it's on a disk
-  FlashInstance->DiskDataInvalidated = TRUE;
+  FvbMarkDiskDataDirty (FlashInstance, Lba, Offset, *NumBytes);
 
   return EFI_SUCCESS;
 }
@@ -947,7 +984,7 @@ FvbEraseBlocks (
       SetMem ((UINTN *)BlockAddress, FlashInstance->Media.BlockSize, 0xFF);
 
       // Must sync the data if it's on a disk
-      FlashInstance->DiskDataInvalidated = TRUE;
+      FvbMarkDiskDataDirty (FlashInstance, StartingLba, 0, FlashInstance->Media.BlockSize);
 
       // Move to the next Lba
       StartingLba++;
@@ -978,6 +1015,7 @@ FvbVirtualNotifyEvent (
 {
   // Convert SPI memory mapped region
   EfiConvertPointer (0x0, (VOID **)&mFvbDevice->RegionBaseAddress);
+  EfiConvertPointer (0x0, (VOID **)&mFvbDevice->DiskDirtyBlocks);
 
   // Convert SPI device description
   // EfiConvertPointer (0x0, (VOID**)&mFvbDevice->SpiDevice.Info);
@@ -1090,6 +1128,15 @@ FvbConfigureFlashInstance (
   // U-Boot maps NV data into memory at the same address as in flash.
   FlashInstance->RegionBaseAddress = FlashInstance->FvbOffset;
 
+  //
+  // The disk copy matches the shadow buffer as loaded, so only blocks
+  // touched from now on need dumping. Without the bitmap the whole
+  // region is written back.
+  //
+  FlashInstance->DiskDirtyBlocks = AllocateRuntimeZeroPool (
+                                     (FlashInstance->FvbSize / FlashInstance->Media.BlockSize + 7) / 8
+                                     );
+
   if (  FlashInstance->IsSpiFlashAvailable
      && (mBootDeviceType != RkAtagBootDevTypeSpiNor)
      && (mBootDeviceType != RkAtagBootDevTypeMtdBlkSpiNor))
@@ -1162,6 +1209,12 @@ FvbDiskDumpNvData (
   EFI_DISK_IO_PROTOCOL  *DiskIo = NULL;
   EFI_HANDLE            Handle;
   UINTN                 DataOffset;
+  UINTN                 BlockSize;
+  UINTN                 NumBlocks;
+  UINTN                 Block;
+  UINTN                 RunEnd;
+  UINTN                 Written;
+  UINT8                 *Dirty;
 
   Status = gBS->LocateDevicePath (&gEfiDiskIoProtocolGuid, &Device, &Handle);
   if (EFI_ERROR (Status)) {
@@ -1179,15 +1232,56 @@ FvbDiskDumpNvData (
                  mFvbDevice->Media.BlockSize
                  );
 
-  Status = DiskIo->WriteDisk (
+  Dirty = mFvbDevice->DiskDirtyBlocks;
+  if (Dirty == NULL) {
+    return DiskIo->WriteDisk (
                      DiskIo,
                      MediaId,
                      DataOffset,
                      mFvbDevice->FvbSize,
                      (VOID *)mFvbDevice->FvbOffset
                      );
+  }
 
-  return Status;
+  //
+  // Only write back the blocks changed since the last dump, merging
+  // adjacent dirty blocks into a single request.
+  //
+  BlockSize = mFvbDevice->Media.BlockSize;
+  NumBlocks = mFvbDevice->FvbSize / BlockSize;
+  Written   = 0;
+
+  for (Block = 0; Block < NumBlocks; Block = RunEnd) {
+    if ((Dirty[Block / 8] & (1 << (Block % 8))) == 0) {
+      RunEnd = Block + 1;
+      continue;
+    }
+
+    for (RunEnd = Block + 1; RunEnd < NumBlocks; RunEnd++) {
+      if ((Dirty[RunEnd / 8] & (1 << (RunEnd % 8))) == 0) {
+        break;
+      }
+    }
+
+    Status = DiskIo->WriteDisk (
+                       DiskIo,
+                       MediaId,
+                       DataOffset + Block * BlockSize,
+                       (RunEnd - Block) * BlockSize,
+                       (VOID *)(mFvbDevice->FvbOffset + Block * BlockSize)
+                       );
+    if (EFI_ERROR (Status)) {
+      return Status;
+    }
+
+    Written += RunEnd - Block;
+  }
+
+  DEBUG ((DEBUG_INFO, "%a: Wrote %lu of %lu blocks\n", __FUNCTION__, Written, NumBlocks));
+
+  ZeroMem (Dirty, (NumBlocks + 7) / 8);
+
+  return EFI_SUCCESS;
 }
 
 STATIC
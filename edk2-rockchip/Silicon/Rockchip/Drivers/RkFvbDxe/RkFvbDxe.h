@@ -48,6 +48,7 @@ typedef struct {
   EFI_DEVICE_PATH_PROTOCOL               *DiskDevice;
   UINT32                                 DiskMediaId;
   BOOLEAN                                DiskDataInvalidated;
+  UINT8                                  *DiskDirtyBlocks; // One bit per FVB block
 
   EFI_HANDLE                             Handle;
 
@@ -2934,6 +2934,7 @@ Vop2ScaleFactor (
       DEBUG ((DEBUG_INFO, "down fac cali: src:%d, dst:%d, fac:0x%x\n", Src, Dst, Factor));
     }
   } else {
+    Factor = VOP2_COMMON_SCL (Src, Dst);
     for (i = 0; i < 100; i++) {
       if (VOP2_COMMON_SCL_FAC_CHECK (Src, Dst, Factor)) {
         break;
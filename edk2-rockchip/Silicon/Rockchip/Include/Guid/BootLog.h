@@ -0,0 +1,39 @@
+/** @file
+
+  Firmware boot log shared with the OS.
+
+  Copyright (c) 2026, agent <agent@local>
+
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#ifndef BOOT_LOG_H_
+#define BOOT_LOG_H_
+
+#define ROCKCHIP_BOOT_LOG_GUID \
+  { 0x67b74b88, 0xcdf0, 0x4ea5, { 0x84, 0x18, 0xb8, 0x5a, 0xe9, 0x48, 0x5f, 0xe3 } }
+
+#define BOOT_LOG_SIGNATURE  SIGNATURE_32 ('R', 'K', 'L', 'G')
+
+#define BOOT_LOG_FLAG_LINE_START  BIT0
+
+//
+// Header of the boot log region. It is followed by a ring of Size bytes
+// holding the serial output of every firmware phase, with each line
+// prefixed by a "[seconds.microseconds] " generic timer timestamp.
+//
+// Written counts all bytes ever logged. Once it exceeds Size, the ring
+// has wrapped and the oldest byte is at offset (Written % Size).
+//
+typedef struct {
+  UINT32    Signature;
+  UINT32    HeaderSize;
+  UINT32    Size;
+  UINT32    Flags;
+  UINT64    Written;
+} BOOT_LOG_HEADER;
+
+extern EFI_GUID  gRockchipBootLogGuid;
+
+#endif // BOOT_LOG_H_
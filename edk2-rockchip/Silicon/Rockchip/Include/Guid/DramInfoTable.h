@@ -0,0 +1,38 @@
+/** @file
+
+  DRAM topology and measured performance shared with the ACPI, SMBIOS
+  and FDT code.
+
+  Copyright (c) 2026, agent <agent@local>
+
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#ifndef DRAM_INFO_TABLE_H_
+#define DRAM_INFO_TABLE_H_
+
+#include <Library/SdramLib.h>
+
+#define ROCKCHIP_DRAM_INFO_TABLE_GUID \
+  { 0x5c2f8b1e, 0x7d43, 0x4a96, { 0xb0, 0x58, 0x2e, 0x91, 0xc4, 0x6a, 0x3f, 0x17 } }
+
+//
+// DataRate is in MT/s and PeakBandwidth is derived from it and the total
+// bus width. The other bandwidths (MB/s) and latency (ns) are measured
+// from a single core, and only again when the DRAM configuration changes.
+// Any of them is 0 if unknown.
+//
+typedef struct {
+  SDRAM_INFO    Sdram;
+  UINT32        DataRate;
+  UINT32        PeakBandwidth;
+  UINT32        ReadBandwidth;
+  UINT32        WriteBandwidth;
+  UINT32        CopyBandwidth;
+  UINT32        ReadLatency;
+} DRAM_INFO_TABLE;
+
+extern EFI_GUID  gRockchipDramInfoTableGuid;
+
+#endif // DRAM_INFO_TABLE_H_
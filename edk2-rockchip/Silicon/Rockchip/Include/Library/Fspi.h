@@ -10,6 +10,11 @@
 #define HAL_FSPI_QUAD_ENABLE
 #define HAL_FSPI_SPEED_THRESHOLD  100000000
 
+/** Transfers below this size are cheaper through the FIFO than through DMA */
+#define HAL_FSPI_DMA_MIN_SIZE  0x100
+/** DMA buffers must own whole cache lines */
+#define HAL_FSPI_DMA_ALIGN  64
+
 /***************************** Structure Definition **************************/
 /** FSPI_CTRL register datalines, addrlines and cmdlines value */
 #define FSPI_LINES_X1  (0)
@@ -77,6 +82,7 @@ struct HAL_FSPI_HOST {
   UINT8              cs;   /**< Should be defined by user in each operation */
   UINT8              mode; /**< Should be defined by user, referring to hal_spi_mem.h */
   UINT8              cell; /**< Record DLL cell for PM resume, Set depend on corresponding device */
+  UINT8              dmaEnable; /**< Allow the internal DMA master for large transfers, must be cleared at runtime */
 };
 
 #define HAL_FSPI_MAX_DELAY_LINE_CELLS  (0xFFU)
@@ -112,6 +118,13 @@ HAL_FSPI_XferData_DMA (
   UINT32                dir
   );
 
+BOOLEAN
+HAL_FSPI_IsDmaCapable (
+  struct HAL_FSPI_HOST  *host,
+  void                  *data,
+  UINT32                len
+  );
+
 RETURN_STATUS
 HAL_FSPI_XferDone (
   struct HAL_FSPI_HOST  *host
@@ -9,6 +9,41 @@
 #ifndef SDRAMLIB_H__
 #define SDRAMLIB_H__
 
+#define SDRAM_MAX_CHANNELS  4
+
+typedef enum {
+  SDRAM_DDR4    = 0,
+  SDRAM_DDR2    = 2,
+  SDRAM_DDR3    = 3,
+  SDRAM_LPDDR2  = 5,
+  SDRAM_LPDDR3  = 6,
+  SDRAM_LPDDR4  = 7,
+  SDRAM_LPDDR4X = 8,
+  SDRAM_LPDDR5  = 9,
+  SDRAM_DDR5    = 10
+} SDRAM_DDRTYPE;
+
+typedef struct {
+  UINT32    SizeMb;
+  UINT8     Ranks;
+  UINT8     BusWidth;     // Bits
+  UINT16    Reserved;
+} SDRAM_CHANNEL_INFO;
+
+//
+// DRAM topology as left by the DDR init blob in the OS registers.
+//
+typedef struct {
+  UINT32                DdrType;  // SDRAM_DDRTYPE
+  UINT32                ChannelCount;
+  SDRAM_CHANNEL_INFO    Channels[SDRAM_MAX_CHANNELS];
+} SDRAM_INFO;
+
+RETURN_STATUS
+SdramGetInfo (
+  OUT SDRAM_INFO  *Info
+  );
+
 UINT64
 SdramGetMemorySize (
   VOID
@@ -83,6 +83,9 @@ struct SPI_NOR {
   UINT32                     size;
   UINT32                     sectorSize;
   UINT32                     eraseSize;
+
+  UINT8                      *bounceBuf;  /**< DMA-able staging buffer for unaligned or high buffers */
+  UINT32                     bounceSize;
 };
 
 typedef enum {
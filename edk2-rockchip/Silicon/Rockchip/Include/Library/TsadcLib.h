@@ -0,0 +1,26 @@
+/** @file
+ *
+ *  Copyright (c) 2026, agent <agent@local>
+ *
+ *  SPDX-License-Identifier: BSD-2-Clause-Patent
+ *
+ **/
+
+#ifndef TSADC_LIB_H__
+#define TSADC_LIB_H__
+
+UINT32
+TsadcGetChannelCount (
+  VOID
+  );
+
+//
+// Returns the last sample of the given sensor in millidegrees Celsius.
+//
+RETURN_STATUS
+TsadcReadTemperature (
+  IN  UINT32  Channel,
+  OUT INT32   *Temperature
+  );
+
+#endif /* TSADC_LIB_H__ */
@@ -21,6 +21,7 @@ STATIC AUTHENTICATED_VARIABLE_HEADER  mVariableHeaderFtw;
 STATIC BOOLEAN                        mVariableHeaderFtwMerged;
 
 STATIC VARIABLE_INDEX_TABLE  mVariableIndexTable;
+STATIC VARIABLE_HASH_TABLE   mVariableHashTable;
 
 /**
   Get the last Write Header pointer.
@@ -1011,6 +1012,191 @@ GetVariableNameOrData (
   CopyMem (Buffer, NameOrData, Size);
 }
 
+/**
+  Accumulate a FNV-1a hash over a buffer.
+
+  @param Hash           Hash of the preceding data.
+  @param Buffer         Pointer to the data.
+  @param Size           Size of the data.
+
+  @return The updated hash.
+
+**/
+STATIC
+UINT32
+HashBuffer (
+  IN UINT32       Hash,
+  IN CONST UINT8  *Buffer,
+  IN UINTN        Size
+  )
+{
+  while (Size-- > 0) {
+    Hash ^= *Buffer++;
+    Hash *= VARIABLE_HASH_FNV_PRIME;
+  }
+
+  return Hash;
+}
+
+/**
+  Compute the lookup hash of a variable name and vendor GUID.
+
+  @param StoreInfo      Pointer to variable store info structure.
+  @param Name           Pointer to the variable name, may be inconsecutive.
+  @param NameSize       Variable name size.
+  @param VendorGuid     Pointer to the vendor GUID.
+
+  @return The hash of the variable name and vendor GUID.
+
+**/
+STATIC
+UINT32
+GetVariableNameHash (
+  IN VARIABLE_STORE_INFO  *StoreInfo,
+  IN CONST CHAR16         *Name,
+  IN UINTN                NameSize,
+  IN CONST EFI_GUID       *VendorGuid
+  )
+{
+  EFI_PHYSICAL_ADDRESS  TargetAddress;
+  EFI_PHYSICAL_ADDRESS  SpareAddress;
+  UINTN                 PartialNameSize;
+  UINT32                Hash;
+
+  Hash = HashBuffer (VARIABLE_HASH_FNV_OFFSET_BASIS, (CONST UINT8 *)VendorGuid, sizeof (EFI_GUID));
+
+  if (StoreInfo->FtwLastWriteData != NULL) {
+    TargetAddress = StoreInfo->FtwLastWriteData->TargetAddress;
+    SpareAddress  = StoreInfo->FtwLastWriteData->SpareAddress;
+    if (((UINTN)Name < (UINTN)TargetAddress) && (((UINTN)Name + NameSize) > (UINTN)TargetAddress)) {
+      //
+      // Name is inconsecutive, the rest of it is in spare block.
+      //
+      PartialNameSize = (UINTN)TargetAddress - (UINTN)Name;
+      Hash            = HashBuffer (Hash, (CONST UINT8 *)Name, PartialNameSize);
+      return HashBuffer (Hash, (CONST UINT8 *)(UINTN)SpareAddress, NameSize - PartialNameSize);
+    }
+  }
+
+  return HashBuffer (Hash, (CONST UINT8 *)Name, NameSize);
+}
+
+/**
+  Scan the variable store once and index all VAR_ADDED type variables
+  by the hash of their name and vendor GUID.
+
+  @param StoreInfo      Pointer to variable store info structure.
+
+**/
+STATIC
+VOID
+BuildVariableHashTable (
+  IN VARIABLE_STORE_INFO  *StoreInfo
+  )
+{
+  VARIABLE_HASH_TABLE  *HashTable;
+  VARIABLE_HEADER      *Variable;
+  VARIABLE_HEADER      *VariableHeader;
+  UINT32               Hash;
+  UINTN                Slot;
+
+  HashTable           = &mVariableHashTable;
+  HashTable->Built    = TRUE;
+  HashTable->Complete = TRUE;
+  HashTable->Count    = 0;
+
+  Variable = GetStartPointer (StoreInfo->VariableStoreHeader);
+  while (GetVariableHeader (StoreInfo, Variable, &VariableHeader)) {
+    if ((VariableHeader->State == VAR_ADDED) || (VariableHeader->State == (VAR_IN_DELETED_TRANSITION & VAR_ADDED))) {
+      if (HashTable->Count >= VARIABLE_HASH_ENTRIES) {
+        DEBUG ((DEBUG_INFO, "%a: Too many variables, falling back to linear lookup.\n", __func__));
+        HashTable->Complete = FALSE;
+        return;
+      }
+
+      Hash = GetVariableNameHash (
+               StoreInfo,
+               GetVariableNamePtr (Variable, StoreInfo->AuthFlag),
+               NameSizeOfVariable (VariableHeader, StoreInfo->AuthFlag),
+               GetVendorGuidPtr (VariableHeader, StoreInfo->AuthFlag)
+               );
+
+      //
+      // Variables sharing a hash end up further along the probe sequence
+      // in store order, which keeps the lookup order of FindVariableEx.
+      //
+      Slot = Hash & (VARIABLE_HASH_SLOTS - 1);
+      while (HashTable->Slots[Slot] != 0) {
+        Slot = (Slot + 1) & (VARIABLE_HASH_SLOTS - 1);
+      }
+
+      HashTable->Entries[HashTable->Count].Hash     = Hash;
+      HashTable->Entries[HashTable->Count].Variable = Variable;
+      HashTable->Count++;
+      HashTable->Slots[Slot] = (UINT16)HashTable->Count;
+    }
+
+    Variable = GetNextVariablePtr (StoreInfo, Variable, VariableHeader);
+  }
+}
+
+/**
+  Find the variable in the hash index of the variable store.
+
+  @param  StoreInfo           Pointer to the store info structure.
+  @param  VariableName        Name of the variable to be found
+  @param  VendorGuid          Vendor GUID to be found.
+  @param  PtrTrack            Variable Track Pointer structure that contains Variable Information.
+
+  @retval  EFI_SUCCESS            Variable found successfully
+  @retval  EFI_NOT_FOUND          Variable not found
+
+**/
+STATIC
+EFI_STATUS
+FindVariableInHashTable (
+  IN VARIABLE_STORE_INFO      *StoreInfo,
+  IN CONST CHAR16             *VariableName,
+  IN CONST EFI_GUID           *VendorGuid,
+  OUT VARIABLE_POINTER_TRACK  *PtrTrack
+  )
+{
+  VARIABLE_HASH_TABLE  *HashTable;
+  VARIABLE_HASH_ENTRY  *Entry;
+  VARIABLE_HEADER      *InDeletedVariable;
+  VARIABLE_HEADER      *VariableHeader;
+  UINT32               Hash;
+  UINTN                Slot;
+
+  HashTable         = &mVariableHashTable;
+  InDeletedVariable = NULL;
+
+  Hash = GetVariableNameHash (StoreInfo, VariableName, StrSize (VariableName), VendorGuid);
+
+  for (Slot = Hash & (VARIABLE_HASH_SLOTS - 1);
+       HashTable->Slots[Slot] != 0;
+       Slot = (Slot + 1) & (VARIABLE_HASH_SLOTS - 1))
+  {
+    Entry = &HashTable->Entries[HashTable->Slots[Slot] - 1];
+    if (Entry->Hash != Hash) {
+      continue;
+    }
+
+    GetVariableHeader (StoreInfo, Entry->Variable, &VariableHeader);
+    if (CompareWithValidVariable (StoreInfo, Entry->Variable, VariableHeader, VariableName, VendorGuid, PtrTrack) == EFI_SUCCESS) {
+      if (VariableHeader->State == (VAR_IN_DELETED_TRANSITION & VAR_ADDED)) {
+        InDeletedVariable = PtrTrack->CurrPtr;
+      } else {
+        return EFI_SUCCESS;
+      }
+    }
+  }
+
+  PtrTrack->CurrPtr = InDeletedVariable;
+
+  return (PtrTrack->CurrPtr == NULL) ? EFI_NOT_FOUND : EFI_SUCCESS;
+}
+
 /**
   Find the variable in the specified variable store.
 
@@ -1063,6 +1249,20 @@ FindVariableEx (
 
   InDeletedVariable = NULL;
 
+  if ((IndexTable != NULL) && (VariableName[0] != 0)) {
+    //
+    // Named lookups go through the hash index, which is built by walking
+    // the whole store on first use.
+    //
+    if (!mVariableHashTable.Built) {
+      BuildVariableHashTable (StoreInfo);
+    }
+
+    if (mVariableHashTable.Complete) {
+      return FindVariableInHashTable (StoreInfo, VariableName, VendorGuid, PtrTrack);
+    }
+  }
+
   //
   // No Variable Address equals zero, so 0 as initial value is safe.
   //
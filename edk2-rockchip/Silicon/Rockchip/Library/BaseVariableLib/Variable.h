@@ -19,6 +19,7 @@
 #include <Guid/SystemNvDataGuid.h>
 #include <Guid/FaultTolerantWrite.h>
 
+#include <Library/BaseLib.h>
 #include <Library/BaseMemoryLib.h>
 #include <Library/BaseVariableLib.h>
 #include <Library/DebugLib.h>
@@ -42,4 +43,32 @@ typedef struct {
   BOOLEAN                                 AuthFlag;
 } VARIABLE_STORE_INFO;
 
+//
+// Name hash index of the NV variable store, built by a single scan on
+// first lookup. Slots hold (entry index + 1) with linear probing, 0 marks
+// an empty slot.
+//
+#define VARIABLE_HASH_ENTRIES  256
+#define VARIABLE_HASH_SLOTS    (VARIABLE_HASH_ENTRIES * 2)
+
+#define VARIABLE_HASH_FNV_OFFSET_BASIS  0x811C9DC5
+#define VARIABLE_HASH_FNV_PRIME         0x01000193
+
+typedef struct {
+  UINT32             Hash;
+  VARIABLE_HEADER    *Variable;
+} VARIABLE_HASH_ENTRY;
+
+typedef struct {
+  BOOLEAN                Built;
+  //
+  // FALSE if the store has more variables than the index can hold,
+  // in which case lookups fall back to walking the store.
+  //
+  BOOLEAN                Complete;
+  UINTN                  Count;
+  UINT16                 Slots[VARIABLE_HASH_SLOTS];
+  VARIABLE_HASH_ENTRY    Entries[VARIABLE_HASH_ENTRIES];
+} VARIABLE_HASH_TABLE;
+
 #endif // _BASE_VARIABLE_H_
@@ -0,0 +1,133 @@
+/** @file
+  Boot log ring buffer, fed by the serial port write path.
+
+  Copyright (c) 2026, agent <agent@local>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+**/
+#include <Uefi.h>
+#include <Library/ArmGenericTimerCounterLib.h>
+#include <Library/BaseLib.h>
+#include <Library/PcdLib.h>
+#include <Library/PrintLib.h>
+#include <Guid/BootLog.h>
+
+#include "Dw8250SerialPortLib.h"
+
+#define BOOT_LOG_HEADER_PTR  ((BOOT_LOG_HEADER *)(UINTN)FixedPcdGet64 (PcdBootLogBase))
+
+/**
+  Start a new, empty boot log.
+
+  Only called once per boot, by the SEC phase instance of the library.
+
+**/
+VOID
+BootLogReset (
+  VOID
+  )
+{
+  BOOT_LOG_HEADER  *Header;
+
+  if (FixedPcdGet32 (PcdBootLogSize) <= sizeof (BOOT_LOG_HEADER)) {
+    return;
+  }
+
+  //
+  // Field by field, as this may run with the MMU off, where
+  // the memory is treated as Device and must be accessed aligned.
+  //
+  Header             = BOOT_LOG_HEADER_PTR;
+  Header->HeaderSize = sizeof (BOOT_LOG_HEADER);
+  Header->Size       = FixedPcdGet32 (PcdBootLogSize) - sizeof (BOOT_LOG_HEADER);
+  Header->Flags      = BOOT_LOG_FLAG_LINE_START;
+  Header->Written    = 0;
+  Header->Signature  = BOOT_LOG_SIGNATURE;
+}
+
+STATIC
+VOID
+BootLogAppend (
+  IN BOOT_LOG_HEADER  *Header,
+  IN CONST UINT8      *Buffer,
+  IN UINTN            NumberOfBytes
+  )
+{
+  UINT8   *Data;
+  UINT64  Written;
+  UINT32  Size;
+
+  Data    = (UINT8 *)Header + Header->HeaderSize;
+  Size    = Header->Size;
+  Written = Header->Written;
+
+  while (NumberOfBytes--) {
+    Data[Written % Size] = *Buffer++;
+    Written++;
+  }
+
+  Header->Written = Written;
+}
+
+/**
+  Append serial output to the boot log, timestamping each new line.
+
+  @param  Buffer           Pointer to the data to log.
+  @param  NumberOfBytes    Number of bytes to log.
+
+**/
+VOID
+BootLogWrite (
+  IN CONST UINT8  *Buffer,
+  IN UINTN        NumberOfBytes
+  )
+{
+  BOOT_LOG_HEADER  *Header;
+  CHAR8            Stamp[24];
+  UINT64           Count;
+  UINT64           Frequency;
+  UINT64           Remainder;
+  UINT64           Seconds;
+  UINTN            Length;
+
+  if (FixedPcdGet32 (PcdBootLogSize) <= sizeof (BOOT_LOG_HEADER)) {
+    return;
+  }
+
+  Header = BOOT_LOG_HEADER_PTR;
+  if ((Header->Signature != BOOT_LOG_SIGNATURE) || (Header->Size == 0)) {
+    return;
+  }
+
+  while (NumberOfBytes > 0) {
+    if ((Header->Flags & BOOT_LOG_FLAG_LINE_START) != 0) {
+      Count     = ArmGenericTimerGetSystemCount ();
+      Frequency = ArmGenericTimerGetTimerFreq ();
+      Seconds   = 0;
+      Remainder = 0;
+      if (Frequency != 0) {
+        Seconds   = DivU64x64Remainder (Count, Frequency, &Remainder);
+        Remainder = DivU64x64Remainder (MultU64x32 (Remainder, 1000000), Frequency, NULL);
+      }
+
+      Length = AsciiSPrint (Stamp, sizeof (Stamp), "[%5lu.%06lu] ", Seconds, Remainder);
+      BootLogAppend (Header, (CONST UINT8 *)Stamp, Length);
+
+      Header->Flags &= ~BOOT_LOG_FLAG_LINE_START;
+    }
+
+    //
+    // Copy up to and including the end of the current line.
+    //
+    for (Length = 0; Length < NumberOfBytes;) {
+      if (Buffer[Length++] == '\n') {
+        Header->Flags |= BOOT_LOG_FLAG_LINE_START;
+        break;
+      }
+    }
+
+    BootLogAppend (Header, Buffer, Length);
+
+    Buffer        += Length;
+    NumberOfBytes -= Length;
+  }
+}
@@ -16,6 +16,8 @@
 
 #include "Dw8250SerialPortLib.h"
 
+STATIC BOOLEAN  mBootLogStarted = FALSE;
+
 /**
   Initialize the serial device hardware.
 
@@ -35,6 +37,11 @@ SerialPortInitialize (
 {
   UINT32  ulUartClkFreq;
 
+  //
+  // Let any pending output go out at the old settings first.
+  //
+  SerialPortFlush ();
+
   MmioWrite8 (UART_LCR_REG, UART_LCR_DLS8);
   MmioWrite8 (UART_FCR_REG, UART_FCR_EN | UART_FCR_RXCLR | UART_FCR_TXCLR);
   MmioWrite8 (UART_LCR_REG, UART_LCR_DLAB | UART_LCR_DLS8);
@@ -46,5 +53,14 @@ SerialPortInitialize (
   MmioWrite8 (UART_LCR_REG, UART_LCR_DLS8);
   MmioWrite8 (UART_IEL_REG, 0x00);
 
+  //
+  // This is the SEC instance of the library, so the boot log
+  // starts here. Later phases just keep appending to it.
+  //
+  if (!mBootLogStarted) {
+    BootLogReset ();
+    mBootLogStarted = TRUE;
+  }
+
   return RETURN_SUCCESS;
 }
@@ -27,6 +27,7 @@
 #define UART_LCR_REG  (SERIAL_0_BASE_ADR + UART_LCR)
 #define UART_LSR_REG  (SERIAL_0_BASE_ADR + UART_LSR)
 #define UART_USR_REG  (SERIAL_0_BASE_ADR + UART_USR)
+#define UART_TFL_REG  (SERIAL_0_BASE_ADR + UART_TFL)
 
 #define UART_RBR  0x00
 #define UART_THR  0x00
@@ -39,6 +40,7 @@
 #define UART_MCR  0x10
 #define UART_LSR  0x14
 #define UART_USR  0x7C
+#define UART_TFL  0x80
 
 /* register definitions */
 
@@ -91,9 +93,13 @@
 #define UART_LSR_DR    0x01
 
 #define UART_USR_BUSY  0x01
+#define UART_USR_TFNF  0x02
+#define UART_USR_TFE   0x04
 
 #define FIFO_MAXSIZE  32
 
+#define UART_TX_FIFO_DEPTH  64
+
 extern UINT8
 SerialPortReadChar (
   VOID
@@ -104,4 +110,20 @@ SerialPortWriteChar (
   UINT8  scShowChar
   );
 
+extern VOID
+SerialPortFlush (
+  VOID
+  );
+
+VOID
+BootLogReset (
+  VOID
+  );
+
+VOID
+BootLogWrite (
+  IN CONST UINT8  *Buffer,
+  IN UINTN        NumberOfBytes
+  );
+
 #endif
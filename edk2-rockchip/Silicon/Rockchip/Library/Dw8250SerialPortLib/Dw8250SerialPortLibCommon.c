@@ -16,6 +16,33 @@
 
 #include "Dw8250SerialPortLib.h"
 
+/**
+  Wait for room in the transmit FIFO.
+
+  @return  The number of bytes that can be written to the FIFO without
+           waiting. If the FIFO did not drain in time, 1 is returned so
+           that the caller pushes the data out anyway.
+
+**/
+STATIC
+UINTN
+SerialPortGetTxFifoSpace (
+  VOID
+  )
+{
+  UINT32  ulLoop;
+  UINT8   Level;
+
+  for (ulLoop = 0; ulLoop < (UINT32)UART_SEND_DELAY; ulLoop++) {
+    Level = MmioRead8 (UART_TFL_REG);
+    if (Level < UART_TX_FIFO_DEPTH) {
+      return UART_TX_FIFO_DEPTH - Level;
+    }
+  }
+
+  return 1;
+}
+
 /**
   Write data from buffer to serial device.
 
@@ -43,6 +70,7 @@ SerialPortWrite (
   )
 {
   UINTN  Result;
+  UINTN  Count;
 
   if (NULL == Buffer) {
     return 0;
@@ -50,9 +78,20 @@ SerialPortWrite (
 
   Result = NumberOfBytes;
 
-  while (NumberOfBytes--) {
-    SerialPortWriteChar (*Buffer);
-    Buffer++;
+  BootLogWrite (Buffer, NumberOfBytes);
+
+  //
+  // Fill the transmit FIFO in bursts. The data is left to drain
+  // while the caller carries on, see SerialPortFlush().
+  //
+  while (NumberOfBytes > 0) {
+    Count          = MIN (SerialPortGetTxFifoSpace (), NumberOfBytes);
+    NumberOfBytes -= Count;
+
+    while (Count--) {
+      MmioWrite8 (UART_THR_REG, *Buffer);
+      Buffer++;
+    }
   }
 
   return Result;
@@ -124,7 +163,7 @@ SerialPortWriteChar (
   UINT32  ulLoop = 0;
 
   while (ulLoop < (UINT32)UART_SEND_DELAY) {
-    if ((MmioRead8 (UART_USR_REG) & 0x02) == 0x02) {
+    if ((MmioRead8 (UART_USR_REG) & UART_USR_TFNF) == UART_USR_TFNF) {
       break;
     }
 
@@ -133,9 +172,22 @@ SerialPortWriteChar (
 
   MmioWrite8 (UART_THR_REG, (UINT8)scShowChar);
 
-  ulLoop = 0;
+  return;
+}
+
+/**
+  Wait for the transmit FIFO to drain.
+
+**/
+VOID
+SerialPortFlush (
+  VOID
+  )
+{
+  UINT32  ulLoop = 0;
+
   while (ulLoop < (UINT32)UART_SEND_DELAY) {
-    if ((MmioRead8 (UART_USR_REG) & 0x04) == 0x04) {
+    if ((MmioRead8 (UART_USR_REG) & UART_USR_TFE) == UART_USR_TFE) {
       break;
     }
 
@@ -244,11 +296,14 @@ SerialPortGetControl (
   OUT UINT32  *Control
   )
 {
-  if (SerialPortPoll ()) {
-    // If a character is pending don't set EFI_SERIAL_INPUT_BUFFER_EMPTY
-    *Control = EFI_SERIAL_OUTPUT_BUFFER_EMPTY;
-  } else {
-    *Control = EFI_SERIAL_INPUT_BUFFER_EMPTY | EFI_SERIAL_OUTPUT_BUFFER_EMPTY;
+  *Control = 0;
+
+  if (!SerialPortPoll ()) {
+    *Control |= EFI_SERIAL_INPUT_BUFFER_EMPTY;
+  }
+
+  if ((MmioRead8 (UART_USR_REG) & UART_USR_TFE) == UART_USR_TFE) {
+    *Control |= EFI_SERIAL_OUTPUT_BUFFER_EMPTY;
   }
 
   return EFI_SUCCESS;
@@ -0,0 +1,139 @@
+/** @file
+  Flush points for the UART Serial Port library in runtime drivers
+
+  Copyright (c) 2026, agent <agent@local>
+
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+**/
+#include <Uefi.h>
+#include <Library/SerialPortLib.h>
+#include <Protocol/ResetNotification.h>
+
+#include "Dw8250SerialPortLib.h"
+
+//
+// UefiBootServicesTableLib can't be used here: it depends on DebugLib,
+// which in turn depends on this library.
+//
+STATIC EFI_BOOT_SERVICES  *mBootServices;
+STATIC EFI_EVENT          mExitBootServicesEvent;
+STATIC EFI_EVENT          mResetNotificationEvent;
+STATIC VOID               *mResetNotificationRegistration;
+
+//
+// SerialPortWrite() returns while the transmit FIFO is still draining.
+// Make sure the last lines go out before the OS takes over the UART
+// or the system resets. Runtime resets don't need this, as there's no
+// debug output at runtime.
+//
+STATIC
+VOID
+EFIAPI
+SerialPortExitBootServicesEvent (
+  IN EFI_EVENT  Event,
+  IN VOID       *Context
+  )
+{
+  SerialPortFlush ();
+}
+
+STATIC
+VOID
+EFIAPI
+SerialPortResetNotify (
+  IN EFI_RESET_TYPE  ResetType,
+  IN EFI_STATUS      ResetStatus,
+  IN UINTN           DataSize,
+  IN VOID            *ResetData OPTIONAL
+  )
+{
+  SerialPortFlush ();
+}
+
+STATIC
+VOID
+EFIAPI
+SerialPortResetNotificationInstalled (
+  IN EFI_EVENT  Event,
+  IN VOID       *Context
+  )
+{
+  EFI_STATUS                       Status;
+  EFI_RESET_NOTIFICATION_PROTOCOL  *ResetNotify;
+
+  Status = mBootServices->LocateProtocol (
+                            &gEfiResetNotificationProtocolGuid,
+                            mResetNotificationRegistration,
+                            (VOID **)&ResetNotify
+                            );
+  if (EFI_ERROR (Status)) {
+    return;
+  }
+
+  ResetNotify->RegisterResetNotify (ResetNotify, SerialPortResetNotify);
+
+  mBootServices->CloseEvent (Event);
+  mResetNotificationEvent = NULL;
+}
+
+EFI_STATUS
+EFIAPI
+RuntimeDw8250SerialPortLibConstructor (
+  IN EFI_HANDLE        ImageHandle,
+  IN EFI_SYSTEM_TABLE  *SystemTable
+  )
+{
+  EFI_STATUS  Status;
+
+  mBootServices = SystemTable->BootServices;
+
+  Status = mBootServices->CreateEvent (
+                            EVT_SIGNAL_EXIT_BOOT_SERVICES,
+                            TPL_NOTIFY,
+                            SerialPortExitBootServicesEvent,
+                            NULL,
+                            &mExitBootServicesEvent
+                            );
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  Status = mBootServices->CreateEvent (
+                            EVT_NOTIFY_SIGNAL,
+                            TPL_CALLBACK,
+                            SerialPortResetNotificationInstalled,
+                            NULL,
+                            &mResetNotificationEvent
+                            );
+  if (EFI_ERROR (Status)) {
+    return EFI_SUCCESS;
+  }
+
+  Status = mBootServices->RegisterProtocolNotify (
+                            &gEfiResetNotificationProtocolGuid,
+                            mResetNotificationEvent,
+                            &mResetNotificationRegistration
+                            );
+  if (!EFI_ERROR (Status)) {
+    //
+    // The protocol may already be installed.
+    //
+    mBootServices->SignalEvent (mResetNotificationEvent);
+  }
+
+  return EFI_SUCCESS;
+}
+
+EFI_STATUS
+EFIAPI
+RuntimeDw8250SerialPortLibDestructor (
+  IN EFI_HANDLE        ImageHandle,
+  IN EFI_SYSTEM_TABLE  *SystemTable
+  )
+{
+  if (mResetNotificationEvent != NULL) {
+    mBootServices->CloseEvent (mResetNotificationEvent);
+  }
+
+  return mBootServices->CloseEvent (mExitBootServicesEvent);
+}
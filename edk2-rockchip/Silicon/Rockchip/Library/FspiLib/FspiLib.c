@@ -5,6 +5,7 @@
  */
 
 #include "Soc.h"
+#include <Library/CacheMaintenanceLib.h>
 #include <Library/DebugLib.h>
 #include <Library/IoLib.h>
 #include <Library/PcdLib.h>
@@ -51,6 +52,7 @@
 
 /* FSPI_RISR */
 #define FSPI_RISR_TRANSS_ACTIVE  (1 << FSPI_RISR_TRANSS_SHIFT)
+#define FSPI_RISR_DMAS_ACTIVE    (1 << FSPI_RISR_DMAS_SHIFT)
 
 /* FSPI attributes */
 #define FSPI_VER_VER_1  1
@@ -395,6 +397,91 @@ HAL_FSPI_XferData (
   return ret;
 }
 
+/**
+ * @brief  Check whether a data buffer can be handed to the FSPI DMA master.
+ * @param  host: FSPI host.
+ * @param  data: transfer buffer.
+ * @param  len: data n bytes.
+ * @return TRUE if the transfer may use DMA.
+ * @attention The DMA master only has a 32-bit address register, and the
+ *  buffer must own whole cache lines so that invalidation cannot discard
+ *  neighbouring data.
+ */
+BOOLEAN
+HAL_FSPI_IsDmaCapable (
+  struct HAL_FSPI_HOST  *host,
+  void                  *data,
+  UINT32                len
+  )
+{
+  UINTN  addr = (UINTN)data;
+
+  if (!host->dmaEnable || (len < HAL_FSPI_DMA_MIN_SIZE)) {
+    return FALSE;
+  }
+
+  if (!HAL_IS_ALIGNED (addr, HAL_FSPI_DMA_ALIGN) ||
+      !HAL_IS_ALIGNED (len, HAL_FSPI_DMA_ALIGN))
+  {
+    return FALSE;
+  }
+
+  return (addr + len - 1) <= MAX_UINT32;
+}
+
+/**
+ * @brief  IO transfer through the FSPI internal DMA master.
+ * @param  host: FSPI host.
+ * @param  len: data n bytes.
+ * @param  data: transfer buffer, must pass HAL_FSPI_IsDmaCapable.
+ * @param  dir: transfer direction.
+ * @return RETURN_STATUS.
+ */
+RETURN_STATUS
+HAL_FSPI_XferData_DMA (
+  struct HAL_FSPI_HOST  *host,
+  UINT32                len,
+  void                  *data,
+  UINT32                dir
+  )
+{
+  RETURN_STATUS    ret     = RETURN_SUCCESS;
+  UINT32           timeout = 0;
+  struct FSPI_REG  *pReg   = host->instance;
+
+  HAL_ASSERT (data && len);
+
+  if (dir == FSPI_WRITE) {
+    WriteBackDataCacheRange (data, len);
+  } else {
+    InvalidateDataCacheRange (data, len);
+  }
+
+  pReg->ICLR    = 0xFFFFFFFF;
+  pReg->DMAADDR = (UINT32)(UINTN)data;
+  pReg->DMATR   = FSPI_DMATR_DMATR_START;
+
+  /* Allow 1us per byte on top of the usual FIFO timeout, enough for x1 lines */
+  while (!(pReg->RISR & FSPI_RISR_DMAS_ACTIVE)) {
+    HAL_CPUDelayUs (1);
+    if (timeout++ > 10000 + len) {
+      FSPI_DBG ("%s dma timeout len %x\n", __func__, len);
+      FSPI_Reset (host);
+      ret = RETURN_TIMEOUT;
+      break;
+    }
+  }
+
+  pReg->ICLR = FSPI_ISR_DMAS_ACTIVE;
+
+  if (dir != FSPI_WRITE) {
+    /* Drop any lines speculatively fetched while the transfer was running */
+    InvalidateDataCacheRange (data, len);
+  }
+
+  return ret;
+}
+
 /**
  * @brief  Wait for FSPI host transfer finished.
  * @return RETURN_STATUS.
@@ -449,7 +536,12 @@ HAL_FSPI_SpiXfer (
 
   HAL_FSPI_XferStart (host, op);
   if (pData) {
-    ret = HAL_FSPI_XferData (host, op->data.nbytes, pData, dir);
+    if (HAL_FSPI_IsDmaCapable (host, pData, op->data.nbytes)) {
+      ret = HAL_FSPI_XferData_DMA (host, op->data.nbytes, pData, dir);
+    } else {
+      ret = HAL_FSPI_XferData (host, op->data.nbytes, pData, dir);
+    }
+
     if (ret) {
       FSPI_DBG ("%s xfer data failed ret %d\n", __func__, ret);
 
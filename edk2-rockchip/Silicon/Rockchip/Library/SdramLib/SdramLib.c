@@ -1,6 +1,6 @@
 /** @file
  *
- *  SDRAM size detection for Rockchip SoCs
+ *  SDRAM size and topology detection for Rockchip SoCs
  *
  *  Copyright (c) 2022, Jared McNeill <jmcneill@invisible.ca>
  *  Copyright (c) 2023, Gábor Stefanik <netrolller.3d@gmail.com>
@@ -17,18 +17,6 @@
 #define SDRAM_OS_REG_BASE  0xFD58A208
 #define SDRAM_BANK_COUNT   2
 
-typedef enum {
-  SDRAM_DDR4    = 0,
-  SDRAM_DDR2    = 2,
-  SDRAM_DDR3    = 3,
-  SDRAM_LPDDR2  = 5,
-  SDRAM_LPDDR3  = 6,
-  SDRAM_LPDDR4  = 7,
-  SDRAM_LPDDR4X = 8,
-  SDRAM_LPDDR5  = 9,
-  SDRAM_DDR5    = 10
-} SDRAM_DDRTYPE;
-
 #define SYS_REG_DDRTYPE(x)           (((x) >> 13) & 0x7)
 #define SYS_REG_CHANNELNUM(x)        (((x) >> 12) & 0x1)
 #define SYS_REG_RANK_CH(x, c)        (((x) >> ((c) ? 27 : 11)) & 0x1)
@@ -46,9 +34,9 @@ typedef enum {
 #define SYS_REG1_CS1_COL_CH(x, c)     (((x) >> ((c) ? 2 : 0)) & 0x3)
 #define SYS_REG1_EXTENDED_DDRTYPE(x)  (((x) >> 12) & 0x3)
 
-UINT64
-SdramGetMemorySize (
-  VOID
+RETURN_STATUS
+SdramGetInfo (
+  OUT SDRAM_INFO  *Info
   )
 {
   UINT32  OsReg;
@@ -64,10 +52,16 @@ SdramGetMemorySize (
   INT32   Row34;
   INT32   Bg;
   INT32   ChSizeMb;
-  INT32   SizeMb = 0;
   UINT32  Version;
   UINT32  DdrType;
 
+  if (Info == NULL) {
+    ASSERT (FALSE);
+    return RETURN_INVALID_PARAMETER;
+  }
+
+  Info->ChannelCount = 0;
+
   for (Bank = 0; Bank < SDRAM_BANK_COUNT; Bank++) {
     OsReg  = MmioRead32 (SDRAM_OS_REG_BASE + 8 * Bank);
     OsReg1 = MmioRead32 (SDRAM_OS_REG_BASE + 8 * Bank + 4);
@@ -81,6 +75,10 @@ SdramGetMemorySize (
 
     ChNum = 1 + SYS_REG_CHANNELNUM (OsReg);
 
+    if (Bank == 0) {
+      Info->DdrType = DdrType;
+    }
+
     DEBUG ((
       DEBUG_INFO,
       "%a(): Bank #%d: %d channel(s), type 0x%X, version 0x%X\n",
@@ -143,8 +141,38 @@ SdramGetMemorySize (
         ChSizeMb = ChSizeMb * 3 / 4;
       }
 
-      DEBUG ((DEBUG_INFO, "%a(): Ch #%d: %u MB\n", __func__, Ch + Bank * 2, ChSizeMb));
-      SizeMb += ChSizeMb;
+      DEBUG ((
+        DEBUG_INFO,
+        "%a(): Ch #%d: %u MB, %d rank(s), %d-bit\n",
+        __func__,
+        Ch + Bank * 2,
+        ChSizeMb,
+        Rank,
+        8 << Bw
+        ));
+
+      Info->Channels[Info->ChannelCount].SizeMb   = ChSizeMb;
+      Info->Channels[Info->ChannelCount].Ranks    = Rank;
+      Info->Channels[Info->ChannelCount].BusWidth = 8 << Bw;
+      Info->ChannelCount++;
+    }
+  }
+
+  return Info->ChannelCount > 0 ? RETURN_SUCCESS : RETURN_NOT_FOUND;
+}
+
+UINT64
+SdramGetMemorySize (
+  VOID
+  )
+{
+  SDRAM_INFO  Info;
+  UINT32      Index;
+  UINT32      SizeMb = 0;
+
+  if (!RETURN_ERROR (SdramGetInfo (&Info))) {
+    for (Index = 0; Index < Info.ChannelCount; Index++) {
+      SizeMb += Info.Channels[Index].SizeMb;
     }
   }
 
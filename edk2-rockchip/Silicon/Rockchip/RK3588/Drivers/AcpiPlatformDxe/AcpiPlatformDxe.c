@@ -10,6 +10,9 @@
  **/
 
 #include <IndustryStandard/AcpiAml.h>
+#include <IndustryStandard/HeterogeneousMemoryAttributeTable.h>
+#include <Guid/DramInfoTable.h>
+#include <Protocol/AcpiTable.h>
 #include <Protocol/ExitBootServicesOsNotify.h>
 #include <Protocol/LoadedImage.h>
 #include <Protocol/NonDiscoverableDevice.h>
@@ -18,6 +21,7 @@
 #include <Library/BaseMemoryLib.h>
 #include <Library/DebugLib.h>
 #include <Library/DevicePathLib.h>
+#include <Library/DxeServicesTableLib.h>
 #include <Library/MemoryAllocationLib.h>
 #include <Library/UefiBootServicesTableLib.h>
 #include <Library/UefiLib.h>
@@ -146,6 +150,262 @@ AcpiDsdtFixupStatus (
   }
 }
 
+STATIC
+VOID
+EFIAPI
+AcpiDsdtFixupCpuIdle (
+  IN EFI_ACPI_SDT_PROTOCOL  *AcpiSdtProtocol,
+  IN EFI_ACPI_HANDLE        TableHandle
+  )
+{
+  EFI_STATUS  Status;
+
+  if (PcdGet8 (PcdAcpiCpuLpiState)) {
+    return;
+  }
+
+  Status = AcpiAmlObjectUpdateInteger (
+             AcpiSdtProtocol,
+             TableHandle,
+             "\\_SB.PKG0.LPIN",
+             1
+             );
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "AcpiPlatform: Failed to disable CPU idle states. Status=%r\n", Status));
+  }
+}
+
+//
+// SRAT/HMAT data types and the CPU count advertised in the MADT.
+//
+#define SRAT_GICC_AFFINITY_COUNT        8
+#define HMAT_DATA_TYPE_READ_LATENCY     1
+#define HMAT_DATA_TYPE_READ_BANDWIDTH   4
+#define HMAT_DATA_TYPE_WRITE_BANDWIDTH  5
+#define HMAT_LOCALITY_INFO_COUNT        3
+
+#pragma pack(1)
+typedef struct {
+  EFI_ACPI_6_4_HMAT_STRUCTURE_SYSTEM_LOCALITY_LATENCY_AND_BANDWIDTH_INFO    Header;
+  UINT32                                                                    InitiatorProximityDomain;
+  UINT32                                                                    TargetProximityDomain;
+  UINT16                                                                    Entry;
+} HMAT_LOCALITY_INFO;
+
+typedef struct {
+  EFI_ACPI_6_4_HETEROGENEOUS_MEMORY_ATTRIBUTE_TABLE_HEADER          Header;
+  EFI_ACPI_6_4_HMAT_STRUCTURE_MEMORY_PROXIMITY_DOMAIN_ATTRIBUTES    Domain;
+  HMAT_LOCALITY_INFO                                                Locality[HMAT_LOCALITY_INFO_COUNT];
+} RK3588_HMAT_TABLE;
+#pragma pack()
+
+STATIC CONST EFI_ACPI_DESCRIPTION_HEADER  mAcpiHeaderTemplate = ACPI_HEADER (0, EFI_ACPI_DESCRIPTION_HEADER, 0);
+
+STATIC
+EFI_STATUS
+AcpiInstallSrat (
+  IN EFI_ACPI_TABLE_PROTOCOL  *AcpiTableProtocol
+  )
+{
+  EFI_STATUS                                          Status;
+  EFI_GCD_MEMORY_SPACE_DESCRIPTOR                     *MemoryMap;
+  UINTN                                               NumberOfDescriptors;
+  UINTN                                               Index;
+  UINTN                                               TableKey;
+  EFI_PHYSICAL_ADDRESS                                RangeBase;
+  EFI_PHYSICAL_ADDRESS                                RangeEnd;
+  EFI_ACPI_6_4_SYSTEM_RESOURCE_AFFINITY_TABLE_HEADER  *Srat;
+  EFI_ACPI_6_4_GICC_AFFINITY_STRUCTURE                *GiccAffinity;
+  EFI_ACPI_6_4_MEMORY_AFFINITY_STRUCTURE              *MemoryAffinity;
+
+  Status = gDS->GetMemorySpaceMap (&NumberOfDescriptors, &MemoryMap);
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  Srat = AllocateZeroPool (
+           sizeof (*Srat) +
+           SRAT_GICC_AFFINITY_COUNT * sizeof (*GiccAffinity) +
+           NumberOfDescriptors * sizeof (*MemoryAffinity)
+           );
+  if (Srat == NULL) {
+    FreePool (MemoryMap);
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  CopyMem (&Srat->Header, &mAcpiHeaderTemplate, sizeof (Srat->Header));
+  Srat->Header.Signature = EFI_ACPI_6_4_SYSTEM_RESOURCE_AFFINITY_TABLE_SIGNATURE;
+  Srat->Header.Revision  = EFI_ACPI_6_4_SYSTEM_RESOURCE_AFFINITY_TABLE_REVISION;
+  Srat->Reserved1        = 1;
+
+  GiccAffinity = (EFI_ACPI_6_4_GICC_AFFINITY_STRUCTURE *)(Srat + 1);
+  for (Index = 0; Index < SRAT_GICC_AFFINITY_COUNT; Index++, GiccAffinity++) {
+    GiccAffinity->Type             = EFI_ACPI_6_4_GICC_AFFINITY;
+    GiccAffinity->Length           = sizeof (*GiccAffinity);
+    GiccAffinity->AcpiProcessorUid = (UINT32)Index;
+    GiccAffinity->Flags            = EFI_ACPI_6_4_GICC_ENABLED;
+  }
+
+  //
+  // The GCD map is sorted by address. Contiguous system memory descriptors
+  // are merged by rewriting the previous affinity structure.
+  //
+  MemoryAffinity = (EFI_ACPI_6_4_MEMORY_AFFINITY_STRUCTURE *)GiccAffinity;
+  RangeBase      = 0;
+  RangeEnd       = 0;
+
+  for (Index = 0; Index < NumberOfDescriptors; Index++) {
+    if (MemoryMap[Index].GcdMemoryType != EfiGcdMemoryTypeSystemMemory) {
+      continue;
+    }
+
+    if ((RangeEnd != 0) && (MemoryMap[Index].BaseAddress == RangeEnd)) {
+      MemoryAffinity--;
+    } else {
+      RangeBase = MemoryMap[Index].BaseAddress;
+    }
+
+    RangeEnd = MemoryMap[Index].BaseAddress + MemoryMap[Index].Length;
+
+    MemoryAffinity->Type            = EFI_ACPI_6_4_MEMORY_AFFINITY;
+    MemoryAffinity->Length          = sizeof (*MemoryAffinity);
+    MemoryAffinity->AddressBaseLow  = (UINT32)RangeBase;
+    MemoryAffinity->AddressBaseHigh = (UINT32)RShiftU64 (RangeBase, 32);
+    MemoryAffinity->LengthLow       = (UINT32)(RangeEnd - RangeBase);
+    MemoryAffinity->LengthHigh      = (UINT32)RShiftU64 (RangeEnd - RangeBase, 32);
+    MemoryAffinity->Flags           = EFI_ACPI_6_4_MEMORY_ENABLED;
+    MemoryAffinity++;
+  }
+
+  Srat->Header.Length = (UINT32)((UINTN)MemoryAffinity - (UINTN)Srat);
+
+  Status = AcpiTableProtocol->InstallAcpiTable (
+                                AcpiTableProtocol,
+                                Srat,
+                                Srat->Header.Length,
+                                &TableKey
+                                );
+
+  FreePool (Srat);
+  FreePool (MemoryMap);
+  return Status;
+}
+
+STATIC
+VOID
+HmatAddLocality (
+  IN OUT RK3588_HMAT_TABLE  *Hmat,
+  IN     UINT8              DataType,
+  IN     UINT64             EntryBaseUnit,
+  IN     UINT32             Value
+  )
+{
+  HMAT_LOCALITY_INFO  *Locality;
+
+  if (Value == 0) {
+    return;
+  }
+
+  Locality = (HMAT_LOCALITY_INFO *)((UINT8 *)Hmat + Hmat->Header.Header.Length);
+
+  Locality->Header.Type                              = EFI_ACPI_6_4_HMAT_TYPE_SYSTEM_LOCALITY_LATENCY_AND_BANDWIDTH_INFO;
+  Locality->Header.Length                            = sizeof (*Locality);
+  Locality->Header.DataType                          = DataType;
+  Locality->Header.NumberOfInitiatorProximityDomains = 1;
+  Locality->Header.NumberOfTargetProximityDomains    = 1;
+  Locality->Header.EntryBaseUnit                     = EntryBaseUnit;
+
+  //
+  // 0 means "no information" and 0xFFFF "unreachable".
+  //
+  Locality->Entry = (UINT16)MIN (Value, MAX_UINT16 - 1);
+
+  Hmat->Header.Header.Length += sizeof (*Locality);
+}
+
+STATIC
+EFI_STATUS
+AcpiInstallHmat (
+  IN EFI_ACPI_TABLE_PROTOCOL  *AcpiTableProtocol,
+  IN DRAM_INFO_TABLE          *DramInfo
+  )
+{
+  RK3588_HMAT_TABLE  Hmat;
+  UINTN              TableKey;
+
+  ZeroMem (&Hmat, sizeof (Hmat));
+
+  CopyMem (&Hmat.Header.Header, &mAcpiHeaderTemplate, sizeof (Hmat.Header.Header));
+  Hmat.Header.Header.Signature = EFI_ACPI_6_4_HETEROGENEOUS_MEMORY_ATTRIBUTE_TABLE_SIGNATURE;
+  Hmat.Header.Header.Revision  = EFI_ACPI_6_4_HETEROGENEOUS_MEMORY_ATTRIBUTE_TABLE_REVISION;
+  Hmat.Header.Header.Length    = OFFSET_OF (RK3588_HMAT_TABLE, Locality);
+
+  Hmat.Domain.Type                                = EFI_ACPI_6_4_HMAT_TYPE_MEMORY_PROXIMITY_DOMAIN_ATTRIBUTES;
+  Hmat.Domain.Length                              = sizeof (Hmat.Domain);
+  Hmat.Domain.Flags.InitiatorProximityDomainValid = 1;
+
+  //
+  // Latency is reported in ns (base unit in ps), bandwidth in MB/s.
+  // Fall back to the theoretical peak if bandwidth couldn't be measured.
+  //
+  HmatAddLocality (&Hmat, HMAT_DATA_TYPE_READ_LATENCY, 1000, DramInfo->ReadLatency);
+  HmatAddLocality (
+    &Hmat,
+    HMAT_DATA_TYPE_READ_BANDWIDTH,
+    1,
+    DramInfo->ReadBandwidth != 0 ? DramInfo->ReadBandwidth : DramInfo->PeakBandwidth
+    );
+  HmatAddLocality (
+    &Hmat,
+    HMAT_DATA_TYPE_WRITE_BANDWIDTH,
+    1,
+    DramInfo->WriteBandwidth != 0 ? DramInfo->WriteBandwidth : DramInfo->PeakBandwidth
+    );
+
+  return AcpiTableProtocol->InstallAcpiTable (
+                              AcpiTableProtocol,
+                              &Hmat,
+                              Hmat.Header.Header.Length,
+                              &TableKey
+                              );
+}
+
+STATIC
+VOID
+AcpiInstallMemoryAttributeTables (
+  VOID
+  )
+{
+  EFI_STATUS               Status;
+  EFI_ACPI_TABLE_PROTOCOL  *AcpiTableProtocol;
+  DRAM_INFO_TABLE          *DramInfo;
+
+  Status = EfiGetSystemConfigurationTable (&gRockchipDramInfoTableGuid, (VOID **)&DramInfo);
+  if (EFI_ERROR (Status)) {
+    return;
+  }
+
+  Status = gBS->LocateProtocol (&gEfiAcpiTableProtocolGuid, NULL, (VOID **)&AcpiTableProtocol);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "AcpiPlatform: Couldn't locate gEfiAcpiTableProtocolGuid! Status=%r\n", Status));
+    return;
+  }
+
+  //
+  // HMAT proximity domains are only meaningful with a matching SRAT.
+  //
+  Status = AcpiInstallSrat (AcpiTableProtocol);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "AcpiPlatform: Failed to install SRAT. Status=%r\n", Status));
+    return;
+  }
+
+  Status = AcpiInstallHmat (AcpiTableProtocol, DramInfo);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "AcpiPlatform: Failed to install HMAT. Status=%r\n", Status));
+  }
+}
+
 STATIC
 VOID
 EFIAPI
@@ -178,6 +438,8 @@ NotifyEndOfDxeEvent (
       ));
   }
 
+  AcpiInstallMemoryAttributeTables ();
+
   TableIndex = 0;
   Status     = AcpiLocateTableBySignature (
                  mAcpiSdtProtocol,
@@ -199,6 +461,7 @@ NotifyEndOfDxeEvent (
   }
 
   AcpiDsdtFixupStatus (mAcpiSdtProtocol, TableHandle);
+  AcpiDsdtFixupCpuIdle (mAcpiSdtProtocol, TableHandle);
 
   mAcpiSdtProtocol->Close (TableHandle);
 }
@@ -331,6 +594,8 @@ AcpiPlatformExitBootServicesOsHandler (
   )
 {
   EXIT_BOOT_SERVICES_OS_TYPE  OsType = Context->OsType;
+  EFI_STATUS                  Status;
+  UINT32                      FanPwmBase;
 
   if ((mAcpiSdtProtocol == NULL) || (mDsdtTable == NULL)) {
     return;
@@ -355,6 +620,22 @@ AcpiPlatformExitBootServicesOsHandler (
 
   AcpiFixupPcieEcam (OsType);
 
+  //
+  // Let the OS drive the fan from the thermal zones, if the firmware
+  // found its PWM channel.
+  //
+  FanPwmBase = PcdGet32 (PcdCoolingFanPwmChannelBase);
+  if (FanPwmBase != 0) {
+    Status = AcpiUpdateSdtNameInteger (mDsdtTable, "FANB", FanPwmBase);
+    if (!EFI_ERROR (Status)) {
+      Status = AcpiUpdateSdtNameInteger (mDsdtTable, "FANE", 1);
+    }
+
+    if (EFI_ERROR (Status)) {
+      DEBUG ((DEBUG_ERROR, "AcpiPlatform: Failed to patch FAN0. Status=%r\n", Status));
+    }
+  }
+
   AcpiUpdateChecksum ((UINT8 *)mDsdtTable, mDsdtTable->Length);
 }
 
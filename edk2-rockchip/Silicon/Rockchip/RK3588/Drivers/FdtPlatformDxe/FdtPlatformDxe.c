@@ -22,6 +22,8 @@
 #include <Library/UefiLib.h>
 #include <libfdt.h>
 
+#include <Guid/CpuOppTable.h>
+#include <Guid/DramInfoTable.h>
 #include <Guid/Fdt.h>
 #include <Guid/FileInfo.h>
 
@@ -427,6 +429,321 @@ FdtFixupVopDevices (
   }
 }
 
+STATIC
+VOID
+EFIAPI
+FdtFixupBootLog (
+  IN VOID  *Fdt
+  )
+{
+  UINT64  Base;
+  UINT64  Size;
+  INT32   Parent;
+  INT32   Node;
+  INT32   Ret;
+  CHAR8   NodeName[32];
+  UINT64  Reg[2];
+
+  Base = FixedPcdGet64 (PcdBootLogBase);
+  Size = FixedPcdGet32 (PcdBootLogSize);
+
+  if (Size == 0) {
+    return;
+  }
+
+  DEBUG ((DEBUG_INFO, "FdtPlatform: Adding boot log reserved memory\n"));
+
+  //
+  // The region is already kept out of the UEFI memory map handed to
+  // the OS. This node just lets it find the log.
+  //
+  Parent = fdt_path_offset (Fdt, "/reserved-memory");
+  if (Parent < 0) {
+    Parent = fdt_add_subnode (Fdt, 0, "reserved-memory");
+    if (Parent < 0) {
+      DEBUG ((
+        DEBUG_ERROR,
+        "FdtPlatform: Couldn't create reserved-memory node. Ret=%a\n",
+        fdt_strerror (Parent)
+        ));
+      return;
+    }
+
+    fdt_setprop_u32 (Fdt, Parent, "#address-cells", 2);
+    fdt_setprop_u32 (Fdt, Parent, "#size-cells", 2);
+    fdt_setprop_empty (Fdt, Parent, "ranges");
+  }
+
+  AsciiSPrint (NodeName, sizeof (NodeName), "boot-log@%lx", Base);
+
+  Node = fdt_add_subnode (Fdt, Parent, NodeName);
+  if (Node < 0) {
+    DEBUG ((
+      DEBUG_ERROR,
+      "FdtPlatform: Couldn't create FDT node '%a'. Ret=%a\n",
+      NodeName,
+      fdt_strerror (Node)
+      ));
+    return;
+  }
+
+  Reg[0] = cpu_to_fdt64 (Base);
+  Reg[1] = cpu_to_fdt64 (Size);
+
+  Ret = fdt_setprop (Fdt, Node, "reg", Reg, sizeof (Reg));
+  if (Ret < 0) {
+    DEBUG ((
+      DEBUG_ERROR,
+      "FdtPlatform: Failed to set 'reg' property for '%a'. Ret=%a\n",
+      NodeName,
+      fdt_strerror (Ret)
+      ));
+    return;
+  }
+
+  fdt_setprop_empty (Fdt, Node, "no-map");
+}
+
+STATIC
+VOID
+EFIAPI
+FdtFixupCpuOpps (
+  IN VOID  *Fdt
+  )
+{
+  EFI_STATUS       Status;
+  CPU_OPP_TABLE    *OppTable;
+  CPU_OPP_CLUSTER  *Cluster;
+  UINT32           ClusterIndex;
+  UINT32           OppIndex;
+  INT32            TableNode;
+  INT32            Node;
+  INT32            Length;
+  INT32            Ret;
+  UINT32           Index;
+  UINT32           Count;
+  CONST UINT64     *HzProp;
+  CONST UINT32     *MicrovoltProp;
+  UINT32           *Microvolts;
+  UINT32           Microvolt;
+  UINT64           Hz;
+  CHAR8            NodePath[32];
+
+  Status = EfiGetSystemConfigurationTable (&gRK3588CpuOppTableGuid, (VOID **)&OppTable);
+  if (EFI_ERROR (Status)) {
+    return;
+  }
+
+  for (ClusterIndex = 0; ClusterIndex < OppTable->ClusterCount; ClusterIndex++) {
+    Cluster = &OppTable->Clusters[ClusterIndex];
+    if (Cluster->Level == CPU_OPP_LEVEL_UNKNOWN) {
+      continue;
+    }
+
+    AsciiSPrint (NodePath, sizeof (NodePath), "/opp-table-cluster%u", ClusterIndex);
+    TableNode = fdt_path_offset (Fdt, NodePath);
+    if (TableNode < 0) {
+      AsciiSPrint (NodePath, sizeof (NodePath), "/cluster%u-opp-table", ClusterIndex);
+      TableNode = fdt_path_offset (Fdt, NodePath);
+      if (TableNode < 0) {
+        continue;
+      }
+    }
+
+    DEBUG ((DEBUG_INFO, "FdtPlatform: Applying L%u voltages to '%a'\n", Cluster->Level, NodePath));
+
+    fdt_for_each_subnode (Node, Fdt, TableNode) {
+      HzProp = fdt_getprop (Fdt, Node, "opp-hz", &Length);
+      if ((HzProp == NULL) || (Length != sizeof (UINT64))) {
+        continue;
+      }
+
+      Hz = fdt64_to_cpu (ReadUnaligned64 (HzProp));
+
+      for (OppIndex = 0; OppIndex < Cluster->OppCount; OppIndex++) {
+        if (Cluster->Opps[OppIndex].Hz == Hz) {
+          break;
+        }
+      }
+
+      if (OppIndex == Cluster->OppCount) {
+        continue;
+      }
+
+      MicrovoltProp = fdt_getprop (Fdt, Node, "opp-microvolt", &Length);
+      if ((MicrovoltProp == NULL) || (Length <= 0) || (Length % sizeof (UINT32) != 0)) {
+        continue;
+      }
+
+      Microvolts = AllocateCopyPool (Length, MicrovoltProp);
+      if (Microvolts == NULL) {
+        return;
+      }
+
+      Count = Length / sizeof (UINT32);
+
+      //
+      // Either a single value or <target min max> triplets, one per supply.
+      // Only lower the target and min voltages, never raise them.
+      //
+      for (Index = 0; Index < Count; Index++) {
+        if ((Count >= 3) && (Index % 3 == 2)) {
+          continue;
+        }
+
+        Microvolt = fdt32_to_cpu (Microvolts[Index]);
+        if (Cluster->Opps[OppIndex].Microvolts < Microvolt) {
+          Microvolts[Index] = cpu_to_fdt32 (Cluster->Opps[OppIndex].Microvolts);
+        }
+      }
+
+      Ret = fdt_setprop_inplace (Fdt, Node, "opp-microvolt", Microvolts, Length);
+      if (Ret < 0) {
+        DEBUG ((
+          DEBUG_ERROR,
+          "FdtPlatform: Failed to set 'opp-microvolt' property in '%a'. Ret=%a\n",
+          NodePath,
+          fdt_strerror (Ret)
+          ));
+      }
+
+      FreePool (Microvolts);
+    }
+  }
+}
+
+STATIC
+CONST CHAR8 *
+GetDdrTypeName (
+  IN UINT32  DdrType
+  )
+{
+  switch (DdrType) {
+    case SDRAM_DDR2:
+      return "ddr2";
+    case SDRAM_DDR3:
+      return "ddr3";
+    case SDRAM_DDR4:
+      return "ddr4";
+    case SDRAM_DDR5:
+      return "ddr5";
+    case SDRAM_LPDDR2:
+      return "lpddr2";
+    case SDRAM_LPDDR3:
+      return "lpddr3";
+    case SDRAM_LPDDR4:
+      return "lpddr4";
+    case SDRAM_LPDDR4X:
+      return "lpddr4x";
+    case SDRAM_LPDDR5:
+      return "lpddr5";
+    default:
+      return "unknown";
+  }
+}
+
+STATIC
+VOID
+EFIAPI
+FdtFixupDramInfo (
+  IN VOID  *Fdt
+  )
+{
+  EFI_STATUS       Status;
+  DRAM_INFO_TABLE  *DramInfo;
+  INT32            Node;
+  INT32            Ret;
+  UINT32           Index;
+  UINT32           Count;
+  UINT32           Sizes[SDRAM_MAX_CHANNELS];
+  UINT32           Ranks[SDRAM_MAX_CHANNELS];
+  UINT32           BusWidths[SDRAM_MAX_CHANNELS];
+
+  Status = EfiGetSystemConfigurationTable (&gRockchipDramInfoTableGuid, (VOID **)&DramInfo);
+  if (EFI_ERROR (Status)) {
+    return;
+  }
+
+  DEBUG ((DEBUG_INFO, "FdtPlatform: Adding DRAM info\n"));
+
+  //
+  // Informational only. The compatible intentionally doesn't match the
+  // vendor DMC binding, so that no devfreq driver takes over the DDR clock.
+  //
+  Node = fdt_add_subnode (Fdt, 0, "dram-info");
+  if (Node < 0) {
+    DEBUG ((
+      DEBUG_ERROR,
+      "FdtPlatform: Couldn't create dram-info node. Ret=%a\n",
+      fdt_strerror (Node)
+      ));
+    return;
+  }
+
+  Count = MIN (DramInfo->Sdram.ChannelCount, SDRAM_MAX_CHANNELS);
+  for (Index = 0; Index < Count; Index++) {
+    Sizes[Index]     = cpu_to_fdt32 (DramInfo->Sdram.Channels[Index].SizeMb);
+    Ranks[Index]     = cpu_to_fdt32 (DramInfo->Sdram.Channels[Index].Ranks);
+    BusWidths[Index] = cpu_to_fdt32 (DramInfo->Sdram.Channels[Index].BusWidth);
+  }
+
+  Ret = fdt_setprop_string (Fdt, Node, "compatible", "rockchip,rk3588-dram-info");
+  if (Ret == 0) {
+    Ret = fdt_setprop_string (Fdt, Node, "dram-type", GetDdrTypeName (DramInfo->Sdram.DdrType));
+  }
+
+  if (Ret == 0) {
+    Ret = fdt_setprop (Fdt, Node, "channel-size-mb", Sizes, Count * sizeof (UINT32));
+  }
+
+  if (Ret == 0) {
+    Ret = fdt_setprop (Fdt, Node, "channel-ranks", Ranks, Count * sizeof (UINT32));
+  }
+
+  if (Ret == 0) {
+    Ret = fdt_setprop (Fdt, Node, "channel-bus-width", BusWidths, Count * sizeof (UINT32));
+  }
+
+  if (Ret == 0) {
+    Ret = fdt_setprop_u32 (Fdt, Node, "data-rate-mts", DramInfo->DataRate);
+  }
+
+  if (Ret == 0) {
+    Ret = fdt_setprop_u32 (Fdt, Node, "peak-bandwidth-mb-per-sec", DramInfo->PeakBandwidth);
+  }
+
+  //
+  // The measured values are only present if the boot-time benchmark ran.
+  //
+  if ((Ret == 0) && (DramInfo->ReadBandwidth != 0)) {
+    Ret = fdt_setprop_u32 (Fdt, Node, "read-bandwidth-mb-per-sec", DramInfo->ReadBandwidth);
+  }
+
+  if ((Ret == 0) && (DramInfo->WriteBandwidth != 0)) {
+    Ret = fdt_setprop_u32 (Fdt, Node, "write-bandwidth-mb-per-sec", DramInfo->WriteBandwidth);
+  }
+
+  if ((Ret == 0) && (DramInfo->CopyBandwidth != 0)) {
+    Ret = fdt_setprop_u32 (Fdt, Node, "copy-bandwidth-mb-per-sec", DramInfo->CopyBandwidth);
+  }
+
+  if ((Ret == 0) && (DramInfo->ReadLatency != 0)) {
+    Ret = fdt_setprop_u32 (Fdt, Node, "read-latency-ns", DramInfo->ReadLatency);
+  }
+
+  if (Ret) {
+    DEBUG ((
+      DEBUG_ERROR,
+      "FdtPlatform: Failed to set dram-info properties. Ret=%a\n",
+      fdt_strerror (Ret)
+      ));
+    //
+    // Don't leave a partially filled node behind.
+    //
+    fdt_del_node (Fdt, Node);
+  }
+}
+
 STATIC
 EFI_STATUS
 EFIAPI
@@ -445,6 +762,9 @@ ApplyPlatformFdtFixups (
   FdtFixupComboPhyDevices (*Fdt);
   FdtFixupPcie3Devices (*Fdt);
   FdtFixupVopDevices (*Fdt);
+  FdtFixupBootLog (*Fdt);
+  FdtFixupCpuOpps (*Fdt);
+  FdtFixupDramInfo (*Fdt);
 
   return EFI_SUCCESS;
 }
@@ -84,6 +84,19 @@ SetupConfigTableVariables (
     ASSERT_EFI_ERROR (Status);
   }
 
+  Size   = sizeof (UINT8);
+  Status = gRT->GetVariable (
+                  L"AcpiCpuLpiState",
+                  &gRK3588DxeFormSetGuid,
+                  NULL,
+                  &Size,
+                  &Var8
+                  );
+  if (EFI_ERROR (Status)) {
+    Status = PcdSet8S (PcdAcpiCpuLpiState, FixedPcdGet8 (PcdAcpiCpuLpiStateDefault));
+    ASSERT_EFI_ERROR (Status);
+  }
+
   FirstFdtCompatModeSupported = FDT_COMPAT_MODE_UNSUPPORTED;
 
   for (Index = 0; Index < ARRAY_SIZE (mFdtCompatModeVarTable); Index++) {
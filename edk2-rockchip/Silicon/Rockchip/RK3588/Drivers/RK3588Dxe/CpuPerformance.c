@@ -7,13 +7,19 @@
 **/
 
 #include <Library/DebugLib.h>
+#include <Library/IoLib.h>
+#include <Library/MemoryAllocationLib.h>
+#include <Library/OtpLib.h>
 #include <Library/RK806.h>
+#include <Library/TimerLib.h>
 #include <Library/UefiBootServicesTableLib.h>
+#include <Library/UefiLib.h>
 #include <Library/UefiRuntimeServicesTableLib.h>
 #include <Protocol/I2c.h>
 #include <Protocol/ArmScmi.h>
 #include <Protocol/ArmScmiClockProtocol.h>
 #include <Protocol/Rk860xRegulator.h>
+#include <Guid/CpuOppTable.h>
 #include <VarStoreData.h>
 
 #include "RK3588DxeFormSetGuid.h"
@@ -25,51 +31,127 @@
 
 #define FREQ_1_MHZ  1000000
 
+#define LITCORE_GRF_BASE   0xFD594000
+#define BIGCORE0_GRF_BASE  0xFD590000
+#define BIGCORE1_GRF_BASE  0xFD592000
+
+#define OTP_SPEC_SERIAL_NUMBER_OFFSET  0x06
+#define OTP_SPEC_SERIAL_NUMBER_MASK    0x1F
+#define OTP_SPEC_SERIAL_NUMBER_J       0x0A
+#define OTP_SPEC_SERIAL_NUMBER_M       0x0D
+
+#define CPU_OPP_LEVELS       8
+#define CPU_PVTM_SAMPLES     4
+#define CPU_PVTM_LEVEL_SKEW  1
+
 typedef struct {
   UINT64    Hz;
   UINT32    Microvolts;
 } OPERATING_PERFORMANCE_POINT;
 
-STATIC CONST OPERATING_PERFORMANCE_POINT  mCPULOppTable[] = {
-  { 408000000,  675000 },
-  { 600000000,  675000 },
-  { 816000000,  675000 },
-  { 1008000000, 675000 },
-  { 1200000000, 712500 },
-  { 1416000000, 762500 },
-  { 1608000000, 850000 },
-  { 1800000000, 950000 }
+typedef struct {
+  UINT64    Hz;
+  UINT32    Microvolts[CPU_OPP_LEVELS];
+} BINNED_OPERATING_PERFORMANCE_POINT;
+
+//
+// Voltages for each PVTM level, taken from the "opp-microvolt-L<n>"
+// properties of the vendor device tree. L0 is the slowest silicon.
+//
+STATIC CONST BINNED_OPERATING_PERFORMANCE_POINT  mCPULBinnedOppTable[] = {
+  { 408000000,  { 675000, 675000, 675000, 675000, 675000, 675000, 675000, 675000 } },
+  { 600000000,  { 675000, 675000, 675000, 675000, 675000, 675000, 675000, 675000 } },
+  { 816000000,  { 675000, 675000, 675000, 675000, 675000, 675000, 675000, 675000 } },
+  { 1008000000, { 675000, 675000, 675000, 675000, 675000, 675000, 675000, 675000 } },
+  { 1200000000, { 712500, 700000, 700000, 687500, 675000, 675000, 675000, 675000 } },
+  { 1416000000, { 762500, 750000, 737500, 725000, 725000, 712500, 712500, 712500 } },
+  { 1608000000, { 850000, 837500, 825000, 812500, 800000, 800000, 787500, 787500 } },
+  { 1800000000, { 950000, 937500, 925000, 912500, 900000, 887500, 875000, 875000 } }
+};
+
+STATIC CONST BINNED_OPERATING_PERFORMANCE_POINT  mCPUBBinnedOppTable[] = {
+  { 408000000,  { 675000,  675000,  675000,  675000,  675000,  675000,  675000,  675000  } },
+  { 600000000,  { 675000,  675000,  675000,  675000,  675000,  675000,  675000,  675000  } },
+  { 816000000,  { 675000,  675000,  675000,  675000,  675000,  675000,  675000,  675000  } },
+  { 1008000000, { 675000,  675000,  675000,  675000,  675000,  675000,  675000,  675000  } },
+  { 1200000000, { 675000,  675000,  675000,  675000,  675000,  675000,  675000,  675000  } },
+  { 1416000000, { 725000,  725000,  712500,  700000,  700000,  687500,  675000,  675000  } },
+  { 1608000000, { 762500,  762500,  750000,  737500,  725000,  712500,  700000,  700000  } },
+  { 1800000000, { 850000,  837500,  825000,  812500,  800000,  787500,  775000,  762500  } },
+  { 2016000000, { 925000,  912500,  900000,  887500,  875000,  862500,  850000,  837500  } },
+  { 2208000000, { 987500,  987500,  987500,  975000,  962500,  950000,  925000,  912500  } },
+  { 2256000000, { 1000000, 1000000, 1000000, 1000000, 1000000, 1000000, 1000000, 1000000 } },
+  { 2304000000, { 1000000, 1000000, 1000000, 1000000, 1000000, 1000000, 1000000, 1000000 } },
+  { 2352000000, { 1000000, 1000000, 1000000, 1000000, 1000000, 1000000, 1000000, 1000000 } },
+  { 2400000000, { 1000000, 1000000, 1000000, 1000000, 1000000, 1000000, 1000000, 1000000 } }
+};
+
+//
+// A PVTM reading above Bounds[N] selects level N + 1.
+//
+STATIC CONST UINT32  mCPULPvtmLevelBounds[] = { 1410, 1434, 1458, 1482, 1506, 1530 };
+STATIC CONST UINT32  mCPUBPvtmLevelBounds[] = { 1595, 1615, 1640, 1675, 1710, 1743, 1776 };
+
+typedef struct {
+  UINTN           GrfAddress;
+  UINT64          Hz;
+  UINT32          Microvolts;
+  UINT32          SampleTimeUs;
+  UINT16          LeakageOtpOffset;
+  CONST UINT32    *LevelBounds;
+  UINT32          LevelBoundCount;
+} CPU_PVTM_CONFIG;
+
+STATIC CONST CPU_PVTM_CONFIG  mCPULPvtmConfig = {
+  LITCORE_GRF_BASE + 0x64, 1416000000, 750000, 1100, 0x19,
+  mCPULPvtmLevelBounds, ARRAY_SIZE (mCPULPvtmLevelBounds)
+};
+
+STATIC CONST CPU_PVTM_CONFIG  mCPUB01PvtmConfig = {
+  BIGCORE0_GRF_BASE + 0x18, 1608000000, 750000, 1100, 0x17,
+  mCPUBPvtmLevelBounds, ARRAY_SIZE (mCPUBPvtmLevelBounds)
 };
 
-STATIC CONST OPERATING_PERFORMANCE_POINT  mCPUBOppTable[] = {
-  { 408000000,  675000  },
-  { 600000000,  675000  },
-  { 816000000,  675000  },
-  { 1008000000, 675000  },
-  { 1200000000, 675000  },
-  { 1416000000, 725000  },
-  { 1608000000, 762500  },
-  { 1800000000, 850000  },
-  { 2016000000, 925000  },
-  { 2208000000, 987500  },
-  { 2256000000, 1000000 },
-  { 2304000000, 1000000 },
-  { 2352000000, 1000000 },
-  { 2400000000, 1000000 }
+STATIC CONST CPU_PVTM_CONFIG  mCPUB23PvtmConfig = {
+  BIGCORE1_GRF_BASE + 0x18, 1608000000, 750000, 1100, 0x18,
+  mCPUBPvtmLevelBounds, ARRAY_SIZE (mCPUBPvtmLevelBounds)
 };
 
+//
+// Filled in from the binned tables by InitCpuOppTables().
+//
+STATIC OPERATING_PERFORMANCE_POINT  mCPULOppTable[ARRAY_SIZE (mCPULBinnedOppTable)];
+STATIC OPERATING_PERFORMANCE_POINT  mCPUB01OppTable[ARRAY_SIZE (mCPUBBinnedOppTable)];
+STATIC OPERATING_PERFORMANCE_POINT  mCPUB23OppTable[ARRAY_SIZE (mCPUBBinnedOppTable)];
+
 typedef struct {
-  UINT32                               ClockId;
-  CONST OPERATING_PERFORMANCE_POINT    *Opp;
-  UINT32                               OppCount;
+  UINT32                                      ClockId;
+  OPERATING_PERFORMANCE_POINT                 *Opp;
+  UINT32                                      OppCount;
+  CONST BINNED_OPERATING_PERFORMANCE_POINT    *BinnedOpp;
+  CONST CPU_PVTM_CONFIG                       *Pvtm;
 } SCMI_OPP_TABLE;
 
 STATIC CONST SCMI_OPP_TABLE  mScmiOppTable[] = {
-  { SCMI_CLK_CPUL,   mCPULOppTable, ARRAY_SIZE (mCPULOppTable) },
-  { SCMI_CLK_CPUB01, mCPUBOppTable, ARRAY_SIZE (mCPUBOppTable) },
-  { SCMI_CLK_CPUB23, mCPUBOppTable, ARRAY_SIZE (mCPUBOppTable) }
+  { SCMI_CLK_CPUL,   mCPULOppTable,   ARRAY_SIZE (mCPULOppTable),   mCPULBinnedOppTable, &mCPULPvtmConfig   },
+  { SCMI_CLK_CPUB01, mCPUB01OppTable, ARRAY_SIZE (mCPUB01OppTable), mCPUBBinnedOppTable, &mCPUB01PvtmConfig },
+  { SCMI_CLK_CPUB23, mCPUB23OppTable, ARRAY_SIZE (mCPUB23OppTable), mCPUBBinnedOppTable, &mCPUB23PvtmConfig }
 };
 
+STATIC BOOLEAN        mCpuOppTablesInitialized = FALSE;
+STATIC CPU_OPP_TABLE  *mCpuOppTable             = NULL;
+
+//
+// Binning state of each cluster. A cluster stays pending until its PVTM
+// could be measured, which needs control of its supply regulator.
+//
+STATIC BOOLEAN    mCpuOppBinningPending[ARRAY_SIZE (mScmiOppTable)];
+STATIC UINT32     mCpuOppLevels[ARRAY_SIZE (mScmiOppTable)];
+STATIC UINT32     mCpuOppLeakages[ARRAY_SIZE (mScmiOppTable)];
+STATIC UINT32     mCpuOppPvtmValues[ARRAY_SIZE (mScmiOppTable)];
+STATIC EFI_EVENT  mRk860xRegulatorEvent = NULL;
+STATIC VOID       *mRk860xRegulatorEventRegistration;
+
 STATIC
 EFI_STATUS
 EFIAPI
@@ -185,7 +267,7 @@ GetOppVoltage (
 }
 
 STATIC
-VOID
+EFI_STATUS
 EFIAPI
 SetRk860xRegulatorByTag (
   IN  UINT32  Tag,
@@ -209,7 +291,7 @@ SetRk860xRegulatorByTag (
                   );
   if (EFI_ERROR (Status)) {
     DEBUG ((DEBUG_WARN, "Couldn't locate gRk860xRegulatorProtocolGuid. Status=%r\n", Status));
-    return;
+    return Status;
   }
 
   FoundReg = FALSE;
@@ -225,7 +307,7 @@ SetRk860xRegulatorByTag (
 
     if (EFI_ERROR (Status)) {
       DEBUG ((DEBUG_ERROR, "Failed to open protocol for reg %d. Status=%r\n", Index));
-      return;
+      break;
     }
 
     if (Rk860xRegulator->Tag != Tag) {
@@ -278,10 +360,18 @@ CloseProtocol:
       break;
     }
   }
+
+  FreePool (HandleBuffer);
+
+  if (!FoundReg) {
+    return EFI_NOT_FOUND;
+  }
+
+  return Status;
 }
 
 STATIC
-VOID
+EFI_STATUS
 EFIAPI
 SetCpuVoltage (
   IN  UINT32  ClockId,
@@ -298,8 +388,296 @@ SetCpuVoltage (
 
   if (ClockId == SCMI_CLK_CPUL) {
     SetCPULittleVoltage (Microvolts);
-  } else {
-    SetRk860xRegulatorByTag (ClockId, Microvolts);
+    return EFI_SUCCESS;
+  }
+
+  return SetRk860xRegulatorByTag (ClockId, Microvolts);
+}
+
+STATIC
+EFI_STATUS
+EFIAPI
+GetCpuPvtmValue (
+  IN  CONST SCMI_OPP_TABLE  *ScmiOppTable,
+  OUT UINT32                *PvtmValue
+  )
+{
+  EFI_STATUS             Status;
+  CONST CPU_PVTM_CONFIG  *Pvtm;
+  UINT64                 OriginalHz;
+  UINT32                 SafeMicrovolts;
+  UINT32                 Value;
+  UINT32                 Sum;
+  UINT32                 Index;
+
+  Pvtm = ScmiOppTable->Pvtm;
+
+  Status = ScmiGetClockRate (ScmiOppTable->ClockId, &OriginalHz);
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  //
+  // The tables still hold the worst-case voltages at this point, so this
+  // is enough for both the current and the measurement frequency.
+  //
+  Status = GetOppVoltage (
+             ScmiOppTable->Opp,
+             ScmiOppTable->OppCount,
+             MAX (OriginalHz, Pvtm->Hz),
+             &SafeMicrovolts
+             );
+  if (EFI_ERROR (Status)) {
+    SafeMicrovolts = ScmiOppTable->Opp[ScmiOppTable->OppCount - 1].Microvolts;
+  }
+
+  Status = SetCpuVoltage (ScmiOppTable->ClockId, SafeMicrovolts);
+  if (EFI_ERROR (Status)) {
+    //
+    // Don't measure with a regulator we can't control. It may not
+    // have been installed yet, so the caller should try again later.
+    //
+    return EFI_NOT_READY;
+  }
+
+  Status = ScmiSetClockRate (ScmiOppTable->ClockId, Pvtm->Hz);
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  SetCpuVoltage (ScmiOppTable->ClockId, Pvtm->Microvolts);
+
+  Sum = 0;
+  for (Index = 0; Index < CPU_PVTM_SAMPLES; Index++) {
+    MicroSecondDelay (Pvtm->SampleTimeUs);
+
+    Value = MmioRead32 (Pvtm->GrfAddress);
+    if ((Value == 0) || (Value == MAX_UINT32)) {
+      //
+      // The PVTPLL isn't running, likely because the cluster is off.
+      //
+      Sum = 0;
+      break;
+    }
+
+    Sum += Value;
+  }
+
+  SetCpuVoltage (ScmiOppTable->ClockId, SafeMicrovolts);
+  ScmiSetClockRate (ScmiOppTable->ClockId, OriginalHz);
+
+  if (Sum == 0) {
+    return EFI_DEVICE_ERROR;
+  }
+
+  *PvtmValue = Sum / CPU_PVTM_SAMPLES;
+  return EFI_SUCCESS;
+}
+
+STATIC
+VOID
+EFIAPI
+InstallCpuOppTable (
+  VOID
+  )
+{
+  EFI_STATUS       Status;
+  CPU_OPP_TABLE    *Table;
+  CPU_OPP_CLUSTER  *Cluster;
+  UINT32           Index;
+  UINT32           OppIndex;
+
+  //
+  // Clusters binned late are updated in place, the table is already
+  // published.
+  //
+  Table = mCpuOppTable;
+  if (Table == NULL) {
+    Table = AllocateZeroPool (sizeof (CPU_OPP_TABLE));
+    if (Table == NULL) {
+      return;
+    }
+  }
+
+  Table->ClusterCount = ARRAY_SIZE (mScmiOppTable);
+
+  for (Index = 0; Index < ARRAY_SIZE (mScmiOppTable); Index++) {
+    Cluster           = &Table->Clusters[Index];
+    Cluster->ClockId  = mScmiOppTable[Index].ClockId;
+    Cluster->Level    = mCpuOppLevels[Index];
+    Cluster->Leakage  = mCpuOppLeakages[Index];
+    Cluster->Pvtm     = mCpuOppPvtmValues[Index];
+    Cluster->OppCount = MIN (mScmiOppTable[Index].OppCount, CPU_OPP_TABLE_MAX_OPPS);
+
+    for (OppIndex = 0; OppIndex < Cluster->OppCount; OppIndex++) {
+      Cluster->Opps[OppIndex].Hz         = mScmiOppTable[Index].Opp[OppIndex].Hz;
+      Cluster->Opps[OppIndex].Microvolts = mScmiOppTable[Index].Opp[OppIndex].Microvolts;
+    }
+  }
+
+  if (mCpuOppTable != NULL) {
+    return;
+  }
+
+  Status = gBS->InstallConfigurationTable (&gRK3588CpuOppTableGuid, Table);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "%a: Failed to install table. Status=%r\n", __FUNCTION__, Status));
+    FreePool (Table);
+    return;
+  }
+
+  mCpuOppTable = Table;
+}
+
+STATIC
+BOOLEAN
+EFIAPI
+InitCpuOppTables (
+  VOID
+  )
+{
+  CONST SCMI_OPP_TABLE  *ScmiOppTable;
+  EFI_STATUS            Status;
+  UINT32                Index;
+  UINT32                OppIndex;
+  UINT32                Level;
+  UINT8                 SpecSerialNumber;
+  UINT8                 Leakage;
+  BOOLEAN               Binning;
+  BOOLEAN               Updated;
+  BOOLEAN               Pending;
+
+  Updated = FALSE;
+
+  if (!mCpuOppTablesInitialized) {
+    Binning = FixedPcdGetBool (PcdCpuOppBinning);
+    if (Binning) {
+      //
+      // The industrial and automotive parts are characterized with
+      // different tables, keep the worst-case voltages for them.
+      //
+      OtpRead (OTP_SPEC_SERIAL_NUMBER_OFFSET, 1, &SpecSerialNumber);
+      SpecSerialNumber &= OTP_SPEC_SERIAL_NUMBER_MASK;
+      if ((SpecSerialNumber == OTP_SPEC_SERIAL_NUMBER_J) ||
+          (SpecSerialNumber == OTP_SPEC_SERIAL_NUMBER_M))
+      {
+        DEBUG ((DEBUG_INFO, "%a: Spec serial number 0x%x, not binning.\n", __FUNCTION__, SpecSerialNumber));
+        Binning = FALSE;
+      }
+    }
+
+    for (Index = 0; Index < ARRAY_SIZE (mScmiOppTable); Index++) {
+      ScmiOppTable = &mScmiOppTable[Index];
+
+      for (OppIndex = 0; OppIndex < ScmiOppTable->OppCount; OppIndex++) {
+        ScmiOppTable->Opp[OppIndex].Hz         = ScmiOppTable->BinnedOpp[OppIndex].Hz;
+        ScmiOppTable->Opp[OppIndex].Microvolts = ScmiOppTable->BinnedOpp[OppIndex].Microvolts[0];
+      }
+
+      mCpuOppLevels[Index]         = CPU_OPP_LEVEL_UNKNOWN;
+      mCpuOppLeakages[Index]       = 0;
+      mCpuOppPvtmValues[Index]     = 0;
+      mCpuOppBinningPending[Index] = Binning;
+    }
+
+    mCpuOppTablesInitialized = TRUE;
+    Updated                  = TRUE;
+  }
+
+  Pending = FALSE;
+
+  for (Index = 0; Index < ARRAY_SIZE (mScmiOppTable); Index++) {
+    ScmiOppTable = &mScmiOppTable[Index];
+
+    if (!mCpuOppBinningPending[Index]) {
+      continue;
+    }
+
+    Status = GetCpuPvtmValue (ScmiOppTable, &mCpuOppPvtmValues[Index]);
+    if (Status == EFI_NOT_READY) {
+      DEBUG ((DEBUG_INFO, "%a: Cluster %u: regulator not ready, binning later.\n", __FUNCTION__, Index));
+      Pending = TRUE;
+      continue;
+    }
+
+    mCpuOppBinningPending[Index] = FALSE;
+    Updated                      = TRUE;
+
+    //
+    // Leakage is only reported, the level is selected by PVTM alone
+    // like the vendor kernel does for this SoC.
+    //
+    OtpRead (ScmiOppTable->Pvtm->LeakageOtpOffset, 1, &Leakage);
+    mCpuOppLeakages[Index] = Leakage;
+
+    if (EFI_ERROR (Status)) {
+      DEBUG ((
+        DEBUG_WARN,
+        "%a: Cluster %u: PVTM unavailable, using worst-case voltages. Status=%r\n",
+        __FUNCTION__,
+        Index,
+        Status
+        ));
+      mCpuOppPvtmValues[Index] = 0;
+      continue;
+    }
+
+    //
+    // There's no temperature compensation yet. A warm die reads lower and
+    // can only select a slower level, never a faster one.
+    //
+    Level = 0;
+    while ((Level < ScmiOppTable->Pvtm->LevelBoundCount) &&
+           (mCpuOppPvtmValues[Index] > ScmiOppTable->Pvtm->LevelBounds[Level]))
+    {
+      Level++;
+    }
+
+    Level = MIN (Level, CPU_OPP_LEVELS - 1);
+    if (Level >= CPU_PVTM_LEVEL_SKEW) {
+      Level -= CPU_PVTM_LEVEL_SKEW;
+    } else {
+      Level = 0;
+    }
+
+    mCpuOppLevels[Index] = Level;
+
+    for (OppIndex = 0; OppIndex < ScmiOppTable->OppCount; OppIndex++) {
+      ScmiOppTable->Opp[OppIndex].Microvolts = ScmiOppTable->BinnedOpp[OppIndex].Microvolts[Level];
+    }
+
+    DEBUG ((
+      DEBUG_INFO,
+      "%a: Cluster %u: leakage=%u pvtm=%u level=L%u\n",
+      __FUNCTION__,
+      Index,
+      mCpuOppLeakages[Index],
+      mCpuOppPvtmValues[Index],
+      Level
+      ));
+  }
+
+  if (Updated) {
+    InstallCpuOppTable ();
+  }
+
+  return Pending;
+}
+
+STATIC
+VOID
+EFIAPI
+OnRk860xRegulatorInstalled (
+  IN EFI_EVENT  Event,
+  IN VOID       *Context
+  )
+{
+  //
+  // Bin the clusters whose regulator wasn't there on the first attempt.
+  //
+  if (!InitCpuOppTables ()) {
+    gBS->CloseEvent (Event);
+    mRk860xRegulatorEvent = NULL;
   }
 }
 
@@ -324,6 +702,16 @@ ApplyCpuClockVariables (
     PcdGet32 (PcdCPUB23ClusterClockCustom)
   };
 
+  if (InitCpuOppTables () && (mRk860xRegulatorEvent == NULL)) {
+    mRk860xRegulatorEvent = EfiCreateProtocolNotifyEvent (
+                              &gRk860xRegulatorProtocolGuid,
+                              TPL_CALLBACK,
+                              OnRk860xRegulatorInstalled,
+                              NULL,
+                              &mRk860xRegulatorEventRegistration
+                              );
+  }
+
   for (Index = 0; Index < ARRAY_SIZE (CPUClusterClockPreset); Index++) {
     ScmiOppTable = mScmiOppTable[Index];
 
@@ -370,6 +758,15 @@ ApplyCpuVoltageVariables (
     PcdGet32 (PcdCPUB23ClusterVoltageCustom)
   };
 
+  //
+  // This is the last chance to bin, the OPPs are handed to the OS next.
+  //
+  InitCpuOppTables ();
+  if (mRk860xRegulatorEvent != NULL) {
+    gBS->CloseEvent (mRk860xRegulatorEvent);
+    mRk860xRegulatorEvent = NULL;
+  }
+
   for (Index = 0; Index < ARRAY_SIZE (CPUClusterVoltageMode); Index++) {
     ScmiOppTable = mScmiOppTable[Index];
 
@@ -0,0 +1,372 @@
+/** @file
+*
+*  DRAM topology and bandwidth/latency measurement.
+*
+*  Copyright (c) 2026, agent <agent@local>
+*
+*  SPDX-License-Identifier: BSD-2-Clause-Patent
+*
+**/
+
+#include <Library/BaseLib.h>
+#include <Library/BaseMemoryLib.h>
+#include <Library/DebugLib.h>
+#include <Library/MemoryAllocationLib.h>
+#include <Library/PcdLib.h>
+#include <Library/SdramLib.h>
+#include <Library/TimerLib.h>
+#include <Library/UefiBootServicesTableLib.h>
+#include <Library/UefiRuntimeServicesTableLib.h>
+#include <Protocol/ArmScmi.h>
+#include <Protocol/ArmScmiClockProtocol.h>
+#include <Guid/DramInfoTable.h>
+
+#include "RK3588DxeFormSetGuid.h"
+#include "DramInfo.h"
+
+#define SCMI_CLK_DDR  4
+
+#define FREQ_1_MHZ  1000000
+
+//
+// Large enough to defeat the 3 MB L3 cache.
+//
+#define DRAM_BENCH_BUFFER_SIZE  SIZE_32MB
+#define DRAM_BENCH_ITERATIONS   4
+#define DRAM_BENCH_STRIDE       64
+#define DRAM_BENCH_LOADS        (256 * 1024)
+
+//
+// Benchmark results cached across boots. Sdram and DataRate are the key:
+// the benchmark only runs again when either of them changes.
+//
+#define DRAM_BENCH_VARIABLE_NAME  L"DramBenchmark"
+
+typedef struct {
+  SDRAM_INFO    Sdram;
+  UINT32        DataRate;
+  UINT32        ReadBandwidth;
+  UINT32        WriteBandwidth;
+  UINT32        CopyBandwidth;
+  UINT32        ReadLatency;
+} DRAM_BENCH_VARSTORE_DATA;
+
+typedef enum {
+  DramBenchRead,
+  DramBenchWrite,
+  DramBenchCopy
+} DRAM_BENCH_TYPE;
+
+STATIC
+UINT32
+GetDramDataRate (
+  VOID
+  )
+{
+  EFI_STATUS           Status;
+  SCMI_CLOCK_PROTOCOL  *ClockProtocol;
+  EFI_GUID             ClockProtocolGuid = ARM_SCMI_CLOCK_PROTOCOL_GUID;
+  UINT64               ClockRate;
+
+  Status = gBS->LocateProtocol (
+                  &ClockProtocolGuid,
+                  NULL,
+                  (VOID **)&ClockProtocol
+                  );
+  if (EFI_ERROR (Status)) {
+    return 0;
+  }
+
+  Status = ClockProtocol->RateGet (ClockProtocol, SCMI_CLK_DDR, &ClockRate);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_WARN, "%a: Failed to get DDR clock rate. Status=%r\n", __func__, Status));
+    return 0;
+  }
+
+  //
+  // Double data rate for all the supported types.
+  //
+  return (UINT32)DivU64x32 (ClockRate * 2, FREQ_1_MHZ);
+}
+
+STATIC
+UINT32
+BytesPerNsToMBps (
+  IN UINT64  Bytes,
+  IN UINT64  Nanoseconds
+  )
+{
+  if (Nanoseconds == 0) {
+    return 0;
+  }
+
+  return (UINT32)DivU64x64Remainder (MultU64x32 (Bytes, 1000), Nanoseconds, NULL);
+}
+
+STATIC
+UINT32
+MeasureBandwidth (
+  IN DRAM_BENCH_TYPE  Type,
+  IN VOID             *Source,
+  IN VOID             *Destination,
+  IN UINTN            Size
+  )
+{
+  UINT64  Start;
+  UINT64  Bytes;
+  UINTN   Iteration;
+
+  Bytes = 0;
+  Start = GetPerformanceCounter ();
+
+  for (Iteration = 0; Iteration < DRAM_BENCH_ITERATIONS; Iteration++) {
+    switch (Type) {
+      case DramBenchRead:
+        //
+        // Both buffers hold the same data, so this scans them entirely.
+        //
+        CompareMem (Source, Destination, Size);
+        Bytes += 2 * Size;
+        break;
+      case DramBenchWrite:
+        SetMem (Destination, Size, (UINT8)Iteration);
+        Bytes += Size;
+        break;
+      case DramBenchCopy:
+        CopyMem (Destination, Source, Size);
+        Bytes += 2 * Size;
+        break;
+    }
+  }
+
+  return BytesPerNsToMBps (Bytes, GetTimeInNanoSecond (GetPerformanceCounter () - Start));
+}
+
+/**
+  Chase pointers through a random single-cycle permutation of the
+  buffer's cache lines, so that every load misses and depends on the
+  previous one.
+**/
+STATIC
+UINT32
+MeasureLatency (
+  IN VOID   *Buffer,
+  IN UINTN  Size
+  )
+{
+  UINTN   Count;
+  UINT32  *Next;
+  UINTN   Index;
+  UINTN   Swap;
+  UINT32  Temp;
+  UINT64  Seed;
+  UINTN   Address;
+  UINT64  Start;
+  UINT64  Nanoseconds;
+
+  Count = Size / DRAM_BENCH_STRIDE;
+
+  Next = AllocatePool (Count * sizeof (UINT32));
+  if (Next == NULL) {
+    return 0;
+  }
+
+  for (Index = 0; Index < Count; Index++) {
+    Next[Index] = (UINT32)Index;
+  }
+
+  //
+  // Sattolo's shuffle, seeded with a fixed value for repeatable results.
+  //
+  Seed = 0x2545F4914F6CDD1DULL;
+  for (Index = Count - 1; Index > 0; Index--) {
+    Seed        = Seed * 6364136223846793005ULL + 1442695040888963407ULL;
+    Swap        = (UINTN)ModU64x32 (RShiftU64 (Seed, 33), (UINT32)Index);
+    Temp        = Next[Index];
+    Next[Index] = Next[Swap];
+    Next[Swap]  = Temp;
+  }
+
+  for (Index = 0; Index < Count; Index++) {
+    *(UINTN *)((UINTN)Buffer + Index * DRAM_BENCH_STRIDE) =
+      (UINTN)Buffer + Next[Index] * DRAM_BENCH_STRIDE;
+  }
+
+  FreePool (Next);
+
+  Address = (UINTN)Buffer;
+  Start   = GetPerformanceCounter ();
+
+  for (Index = 0; Index < DRAM_BENCH_LOADS; Index++) {
+    Address = *(volatile UINTN *)Address;
+  }
+
+  Nanoseconds = GetTimeInNanoSecond (GetPerformanceCounter () - Start);
+
+  return (UINT32)DivU64x32 (Nanoseconds, DRAM_BENCH_LOADS);
+}
+
+STATIC
+VOID
+MeasureDramPerformance (
+  IN OUT DRAM_INFO_TABLE  *Table
+  )
+{
+  UINTN  Pages;
+  VOID   *Source;
+  VOID   *Destination;
+
+  Pages = EFI_SIZE_TO_PAGES (DRAM_BENCH_BUFFER_SIZE);
+
+  Source      = AllocatePages (Pages);
+  Destination = AllocatePages (Pages);
+  if ((Source == NULL) || (Destination == NULL)) {
+    DEBUG ((DEBUG_WARN, "%a: Out of memory, skipping.\n", __func__));
+    goto Exit;
+  }
+
+  SetMem (Source, DRAM_BENCH_BUFFER_SIZE, 0x5A);
+  CopyMem (Destination, Source, DRAM_BENCH_BUFFER_SIZE);
+
+  Table->ReadBandwidth  = MeasureBandwidth (DramBenchRead, Source, Destination, DRAM_BENCH_BUFFER_SIZE);
+  Table->CopyBandwidth  = MeasureBandwidth (DramBenchCopy, Source, Destination, DRAM_BENCH_BUFFER_SIZE);
+  Table->WriteBandwidth = MeasureBandwidth (DramBenchWrite, Source, Destination, DRAM_BENCH_BUFFER_SIZE);
+  Table->ReadLatency    = MeasureLatency (Source, DRAM_BENCH_BUFFER_SIZE);
+
+Exit:
+  if (Source != NULL) {
+    FreePages (Source, Pages);
+  }
+
+  if (Destination != NULL) {
+    FreePages (Destination, Pages);
+  }
+}
+
+STATIC
+BOOLEAN
+LoadDramPerformance (
+  IN OUT DRAM_INFO_TABLE  *Table
+  )
+{
+  EFI_STATUS                Status;
+  DRAM_BENCH_VARSTORE_DATA  Data;
+  UINTN                     Size;
+
+  Size   = sizeof (Data);
+  Status = gRT->GetVariable (
+                  DRAM_BENCH_VARIABLE_NAME,
+                  &gRK3588DxeFormSetGuid,
+                  NULL,
+                  &Size,
+                  &Data
+                  );
+  if (EFI_ERROR (Status) || (Size != sizeof (Data))) {
+    return FALSE;
+  }
+
+  if ((CompareMem (&Data.Sdram, &Table->Sdram, sizeof (SDRAM_INFO)) != 0) ||
+      (Data.DataRate != Table->DataRate))
+  {
+    DEBUG ((DEBUG_INFO, "%a: DRAM configuration changed.\n", __func__));
+    return FALSE;
+  }
+
+  Table->ReadBandwidth  = Data.ReadBandwidth;
+  Table->WriteBandwidth = Data.WriteBandwidth;
+  Table->CopyBandwidth  = Data.CopyBandwidth;
+  Table->ReadLatency    = Data.ReadLatency;
+
+  return TRUE;
+}
+
+STATIC
+VOID
+SaveDramPerformance (
+  IN DRAM_INFO_TABLE  *Table
+  )
+{
+  EFI_STATUS                Status;
+  DRAM_BENCH_VARSTORE_DATA  Data;
+
+  ZeroMem (&Data, sizeof (Data));
+  CopyMem (&Data.Sdram, &Table->Sdram, sizeof (SDRAM_INFO));
+  Data.DataRate       = Table->DataRate;
+  Data.ReadBandwidth  = Table->ReadBandwidth;
+  Data.WriteBandwidth = Table->WriteBandwidth;
+  Data.CopyBandwidth  = Table->CopyBandwidth;
+  Data.ReadLatency    = Table->ReadLatency;
+
+  Status = gRT->SetVariable (
+                  DRAM_BENCH_VARIABLE_NAME,
+                  &gRK3588DxeFormSetGuid,
+                  EFI_VARIABLE_NON_VOLATILE | EFI_VARIABLE_BOOTSERVICE_ACCESS,
+                  sizeof (Data),
+                  &Data
+                  );
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_WARN, "%a: Failed to save results. Status=%r\n", __func__, Status));
+  }
+}
+
+VOID
+EFIAPI
+InstallDramInfoTable (
+  VOID
+  )
+{
+  EFI_STATUS       Status;
+  DRAM_INFO_TABLE  *Table;
+  UINT32           Index;
+  UINT32           BusWidth;
+
+  Table = AllocateZeroPool (sizeof (DRAM_INFO_TABLE));
+  if (Table == NULL) {
+    return;
+  }
+
+  Status = SdramGetInfo (&Table->Sdram);
+  if (RETURN_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "%a: Failed to get DRAM topology. Status=%r\n", __func__, Status));
+    FreePool (Table);
+    return;
+  }
+
+  BusWidth = 0;
+  for (Index = 0; Index < Table->Sdram.ChannelCount; Index++) {
+    BusWidth += Table->Sdram.Channels[Index].BusWidth;
+  }
+
+  Table->DataRate      = GetDramDataRate ();
+  Table->PeakBandwidth = Table->DataRate * BusWidth / 8;
+
+  //
+  // The benchmark costs about 0.2 s of boot time, so it only runs on
+  // the first boot and after the DRAM configuration changes.
+  //
+  if (FixedPcdGetBool (PcdDramBenchmark) && !LoadDramPerformance (Table)) {
+    MeasureDramPerformance (Table);
+    if (Table->ReadBandwidth != 0) {
+      SaveDramPerformance (Table);
+    }
+  }
+
+  DEBUG ((
+    DEBUG_INFO,
+    "%a: %u MT/s, %u-bit, peak %u MB/s, read %u MB/s, write %u MB/s, copy %u MB/s, latency %u ns\n",
+    __func__,
+    Table->DataRate,
+    BusWidth,
+    Table->PeakBandwidth,
+    Table->ReadBandwidth,
+    Table->WriteBandwidth,
+    Table->CopyBandwidth,
+    Table->ReadLatency
+    ));
+
+  Status = gBS->InstallConfigurationTable (&gRockchipDramInfoTableGuid, Table);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "%a: Failed to install table. Status=%r\n", __func__, Status));
+    FreePool (Table);
+  }
+}
@@ -0,0 +1,18 @@
+/** @file
+*
+*  Copyright (c) 2026, agent <agent@local>
+*
+*  SPDX-License-Identifier: BSD-2-Clause-Patent
+*
+**/
+
+#ifndef __RK3588DXE_DRAM_INFO_H__
+#define __RK3588DXE_DRAM_INFO_H__
+
+VOID
+EFIAPI
+InstallDramInfoTable (
+  VOID
+  );
+
+#endif // __RK3588DXE_DRAM_INFO_H__
@@ -6,14 +6,210 @@
  *
  **/
 
+#include <Library/BaseLib.h>
 #include <Library/DebugLib.h>
+#include <Library/IoLib.h>
+#include <Library/UefiBootServicesTableLib.h>
 #include <Library/UefiRuntimeServicesTableLib.h>
+#include <Library/PWMLib.h>
+#include <Library/TsadcLib.h>
 #include <VarStoreData.h>
 
 #include <Library/RockchipPlatformLib.h>
 #include "RK3588DxeFormSetGuid.h"
 #include "FanControl.h"
 
+#define PWM_CHANNEL_COUNT   4
+#define PWM_CHANNEL_STRIDE  0x10
+
+STATIC CONST UINT32  mPwmControllerBase[] = {
+  RK3588_PWM0_BASE,
+  RK3588_PWM1_BASE,
+  RK3588_PWM2_BASE,
+  RK3588_PWM3_BASE
+};
+
+STATIC EFI_EVENT  mFanControlTimerEvent;
+STATIC EFI_EVENT  mFanControlExitBootServicesEvent;
+STATIC UINT32     mFanPercentage;
+
+/**
+  PwmFanSetSpeed() does not say which PWM channel it drives, so look
+  for the enabled channel whose duty cycle follows the fan speed.
+  The OS gets to control the fan through it in ACPI mode.
+
+  @retval The register base of the fan PWM channel, or 0 if the board
+          fan is not driven by a SoC PWM channel.
+**/
+STATIC
+UINT32
+FindFanPwmChannel (
+  VOID
+  )
+{
+  UINT32  Controller;
+  UINT32  Channel;
+  UINT32  Base;
+  UINT32  Found;
+  UINT32  Period;
+
+  Found = 0;
+
+  PwmFanSetSpeed (FAN_PERCENTAGE_MIN);
+
+  for (Controller = 0; Controller < ARRAY_SIZE (mPwmControllerBase); Controller++) {
+    for (Channel = 0; Channel < PWM_CHANNEL_COUNT; Channel++) {
+      Base = mPwmControllerBase[Controller] + Channel * PWM_CHANNEL_STRIDE;
+
+      if (((MmioRead32 (Base + PWM_PWM0_CTRL_OFFSET) & PWM_PWM0_CTRL_PWM_EN_MASK) == 0) ||
+          (MmioRead32 (Base + PWM_PWM0_DUTY_LPR_OFFSET) != 0))
+      {
+        continue;
+      }
+
+      PwmFanSetSpeed (FAN_PERCENTAGE_MAX);
+
+      Period = MmioRead32 (Base + PWM_PWM0_PERIOD_HPR_OFFSET);
+      if ((Period != 0) && (MmioRead32 (Base + PWM_PWM0_DUTY_LPR_OFFSET) == Period)) {
+        Found = Base;
+      }
+
+      PwmFanSetSpeed (FAN_PERCENTAGE_MIN);
+
+      if (Found != 0) {
+        return Found;
+      }
+    }
+  }
+
+  return 0;
+}
+
+STATIC
+UINT32
+FanCurvePercentage (
+  IN INT32  Temperature
+  )
+{
+  if (Temperature < FAN_CURVE_TEMP_LOW) {
+    return FAN_PERCENTAGE_MIN;
+  }
+
+  if (Temperature >= FAN_CURVE_TEMP_HIGH) {
+    return FAN_PERCENTAGE_MAX;
+  }
+
+  return FAN_CURVE_PERCENTAGE_LOW +
+         (UINT32)(Temperature - FAN_CURVE_TEMP_LOW) *
+         (FAN_PERCENTAGE_MAX - FAN_CURVE_PERCENTAGE_LOW) /
+         (FAN_CURVE_TEMP_HIGH - FAN_CURVE_TEMP_LOW);
+}
+
+STATIC
+VOID
+EFIAPI
+FanControlTimerHandler (
+  IN EFI_EVENT  Event,
+  IN VOID       *Context
+  )
+{
+  RETURN_STATUS  Status;
+  UINT32         Channel;
+  INT32          Temperature;
+  INT32          MaxTemperature;
+  UINT32         Percentage;
+
+  MaxTemperature = MIN_INT32;
+
+  for (Channel = 0; Channel < TsadcGetChannelCount (); Channel++) {
+    Status = TsadcReadTemperature (Channel, &Temperature);
+    if (!RETURN_ERROR (Status)) {
+      MaxTemperature = MAX (MaxTemperature, Temperature);
+    }
+  }
+
+  if (MaxTemperature == MIN_INT32) {
+    return;
+  }
+
+  //
+  // Speed up right away, but only slow down once the temperature
+  // has dropped past the hysteresis band.
+  //
+  Percentage = FanCurvePercentage (MaxTemperature);
+  if (Percentage < mFanPercentage) {
+    Percentage = MIN (FanCurvePercentage (MaxTemperature + FAN_CURVE_HYSTERESIS), mFanPercentage);
+  }
+
+  if (Percentage != mFanPercentage) {
+    DEBUG ((DEBUG_INFO, "%a: %d mC -> %u%%\n", __func__, MaxTemperature, Percentage));
+    PwmFanSetSpeed (Percentage);
+    mFanPercentage = Percentage;
+  }
+}
+
+STATIC
+VOID
+EFIAPI
+FanControlExitBootServicesHandler (
+  IN EFI_EVENT  Event,
+  IN VOID       *Context
+  )
+{
+  gBS->SetTimer (mFanControlTimerEvent, TimerCancel, 0);
+
+  //
+  // Hand over at the configured speed until the OS takes control.
+  //
+  PwmFanSetSpeed (PcdGet32 (PcdCoolingFanSpeed));
+}
+
+STATIC
+VOID
+StartFanControl (
+  VOID
+  )
+{
+  EFI_STATUS  Status;
+
+  Status = PcdSet32S (PcdCoolingFanPwmChannelBase, FindFanPwmChannel ());
+  ASSERT_EFI_ERROR (Status);
+
+  //
+  // Start at full speed, the first sample brings it down.
+  //
+  mFanPercentage = FAN_PERCENTAGE_MAX;
+  PwmFanSetSpeed (mFanPercentage);
+
+  Status = gBS->CreateEvent (
+                  EVT_TIMER | EVT_NOTIFY_SIGNAL,
+                  TPL_CALLBACK,
+                  FanControlTimerHandler,
+                  NULL,
+                  &mFanControlTimerEvent
+                  );
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "%a: Failed to create timer event. Status=%r\n", __func__, Status));
+    return;
+  }
+
+  Status = gBS->SetTimer (
+                  mFanControlTimerEvent,
+                  TimerPeriodic,
+                  EFI_TIMER_PERIOD_MILLISECONDS (FAN_CONTROL_PERIOD_MS)
+                  );
+  ASSERT_EFI_ERROR (Status);
+
+  Status = gBS->CreateEvent (
+                  EVT_SIGNAL_EXIT_BOOT_SERVICES,
+                  TPL_NOTIFY,
+                  FanControlExitBootServicesHandler,
+                  NULL,
+                  &mFanControlExitBootServicesEvent
+                  );
+  ASSERT_EFI_ERROR (Status);
+}
+
 VOID
 EFIAPI
 ApplyCoolingFanVariables (
@@ -26,6 +222,9 @@ ApplyCoolingFanVariables (
     Var32 = PcdGet32 (PcdCoolingFanSpeed);
     PwmFanIoSetup ();
     PwmFanSetSpeed (Var32);
+  } else if (Var32 == COOLING_FAN_STATE_AUTO) {
+    PwmFanIoSetup ();
+    StartFanControl ();
   }
 }
 
@@ -49,7 +248,7 @@ SetupCoolingFanVariables (
                   &Var32
                   );
   if (EFI_ERROR (Status)) {
-    Status = PcdSet32S (PcdCoolingFanState, 1);
+    Status = PcdSet32S (PcdCoolingFanState, COOLING_FAN_STATE_AUTO);
     ASSERT_EFI_ERROR (Status);
   }
 
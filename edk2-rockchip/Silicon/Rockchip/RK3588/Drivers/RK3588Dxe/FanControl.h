@@ -14,6 +14,17 @@
 #define FAN_PERCENTAGE_STEP     1
 #define FAN_PERCENTAGE_DEFAULT  50
 
+//
+// Automatic mode: off below FAN_CURVE_TEMP_LOW, then linear from
+// FAN_CURVE_PERCENTAGE_LOW up to full speed at FAN_CURVE_TEMP_HIGH.
+// Temperatures are in millidegrees Celsius.
+//
+#define FAN_CONTROL_PERIOD_MS     1000
+#define FAN_CURVE_TEMP_LOW        45000
+#define FAN_CURVE_TEMP_HIGH       75000
+#define FAN_CURVE_HYSTERESIS      3000
+#define FAN_CURVE_PERCENTAGE_LOW  30
+
 //
 // Don't declare these in the VFR file.
 //
@@ -27,6 +27,7 @@
 #include <Library/RK806.h>
 #include <Library/Rk3588Pcie.h>
 #include <VarStoreData.h>
+#include <Guid/BootLog.h>
 #include <Soc.h>
 #include <RK3588RegsPeri.h>
 
@@ -40,6 +41,7 @@
 #include "UsbDpPhy.h"
 #include "DebugSerialPort.h"
 #include "Display.h"
+#include "DramInfo.h"
 
 extern UINT8  RK3588DxeHiiBin[];
 extern UINT8  RK3588DxeStrings[];
@@ -211,6 +213,8 @@ AfterApplyVariablesInit (
   )
 {
   InstallSataDevices ();
+
+  InstallDramInfoTable ();
 }
 
 STATIC
@@ -430,6 +434,34 @@ RK3588NotifyReadyToBoot (
   gBS->CloseEvent (Event);
 }
 
+STATIC
+VOID
+InstallBootLogTable (
+  VOID
+  )
+{
+  EFI_STATUS       Status;
+  BOOT_LOG_HEADER  *Header;
+
+  if (FixedPcdGet32 (PcdBootLogSize) == 0) {
+    return;
+  }
+
+  Header = (BOOT_LOG_HEADER *)(UINTN)FixedPcdGet64 (PcdBootLogBase);
+  if (Header->Signature != BOOT_LOG_SIGNATURE) {
+    DEBUG ((DEBUG_WARN, "%a: Boot log not initialized.\n", __FUNCTION__));
+    return;
+  }
+
+  //
+  // Let the OS find the log. It keeps filling up until ExitBootServices.
+  //
+  Status = gBS->InstallConfigurationTable (&gRockchipBootLogGuid, Header);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "%a: Failed to install table. Status=%r\n", __FUNCTION__, Status));
+  }
+}
+
 EFI_STATUS
 EFIAPI
 RK3588EntryPoint (
@@ -443,6 +475,8 @@ RK3588EntryPoint (
 
   PlatformEarlyInit ();
 
+  InstallBootLogTable ();
+
   //
   // We actually depend on gEfiVariableWriteArchProtocolGuid but don't want to
   // delay the entire driver, so we create a notify event on protocol arrival instead
@@ -0,0 +1,50 @@
+/** @file
+
+  Binned CPU operating performance points shared with the FDT code.
+
+  Copyright (c) 2026, agent <agent@local>
+
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#ifndef CPU_OPP_TABLE_H_
+#define CPU_OPP_TABLE_H_
+
+#define RK3588_CPU_OPP_TABLE_GUID \
+  { 0x98a7a599, 0x1031, 0x40c8, { 0xa3, 0x7e, 0x1a, 0x3c, 0x78, 0x85, 0x00, 0x0d } }
+
+#define CPU_OPP_TABLE_MAX_CLUSTERS  3
+#define CPU_OPP_TABLE_MAX_OPPS      16
+
+#define CPU_OPP_LEVEL_UNKNOWN  MAX_UINT32
+
+typedef struct {
+  UINT64    Hz;
+  UINT32    Microvolts;
+  UINT32    Reserved;
+} CPU_OPP;
+
+//
+// Clusters are ordered as CPU0-3 (little), CPU4-5 and CPU6-7 (big).
+// Level is the voltage bin selected from the PVTM measurement, with
+// CPU_OPP_LEVEL_UNKNOWN meaning the worst-case voltages are used.
+//
+typedef struct {
+  UINT32     ClockId;
+  UINT32     Level;
+  UINT32     Leakage;
+  UINT32     Pvtm;
+  UINT32     OppCount;
+  CPU_OPP    Opps[CPU_OPP_TABLE_MAX_OPPS];
+} CPU_OPP_CLUSTER;
+
+typedef struct {
+  UINT32             ClusterCount;
+  UINT32             Reserved;
+  CPU_OPP_CLUSTER    Clusters[CPU_OPP_TABLE_MAX_CLUSTERS];
+} CPU_OPP_TABLE;
+
+extern EFI_GUID  gRK3588CpuOppTableGuid;
+
+#endif // CPU_OPP_TABLE_H_
@@ -75,11 +75,14 @@ typedef enum {
   MCLK_I2S0_8CH_TX,
   MCLK_I2S1_8CH_TX,
   CLK_SARADC,
+  CLK_TSADC,
   CLK_COUNT
 } RK3588_CLOCK_IDS;
 
 typedef enum {
   RESET_SRST_P_SARADC = 0,
+  RESET_SRST_P_TSADC,
+  RESET_SRST_TSADC,
   RESET_COUNT
 } RK3588_RESET_IDS;
 
@@ -74,6 +74,10 @@ typedef struct {
   UINT32    Mode;
 } ACPI_PCIE_ECAM_COMPAT_MODE_VARSTORE_DATA;
 
+typedef struct {
+  UINT8    State;
+} ACPI_CPU_LPI_STATE_VARSTORE_DATA;
+
 #define FDT_COMPAT_MODE_UNSUPPORTED  0
 #define FDT_COMPAT_MODE_VENDOR       1
 #define FDT_COMPAT_MODE_MAINLINE     2
@@ -97,6 +101,7 @@ typedef struct {
 
 #define COOLING_FAN_STATE_DISABLED  0
 #define COOLING_FAN_STATE_ENABLED   1
+#define COOLING_FAN_STATE_AUTO      2
 typedef struct {
   UINT32    State;
 } COOLING_FAN_STATE_VARSTORE_DATA;
@@ -21,7 +21,7 @@ UINT64         mSystemMemoryBase = FixedPcdGet64 (PcdSystemMemoryBase);
 STATIC UINT64  mSystemMemorySize = FixedPcdGet64 (PcdSystemMemorySize);
 
 // The total number of descriptors, including the final "end-of-table" descriptor.
-#define MAX_VIRTUAL_MEMORY_MAP_DESCRIPTORS  12
+#define MAX_VIRTUAL_MEMORY_MAP_DESCRIPTORS  13
 
 STATIC BOOLEAN                    VirtualMemoryInfoInitialized = FALSE;
 STATIC RK3588_MEMORY_REGION_INFO  VirtualMemoryInfo[MAX_VIRTUAL_MEMORY_MAP_DESCRIPTORS];
@@ -84,6 +84,16 @@ ArmPlatformGetVirtualMemoryMap (
   VirtualMemoryInfo[Index].Type          = RK3588_MEM_RESERVED_REGION;
   VirtualMemoryInfo[Index++].Name        = L"UEFI FV";
 
+  if (FixedPcdGet32 (PcdBootLogSize) != 0) {
+    // Boot Log
+    VirtualMemoryTable[Index].PhysicalBase = FixedPcdGet64 (PcdBootLogBase);
+    VirtualMemoryTable[Index].VirtualBase  = VirtualMemoryTable[Index].PhysicalBase;
+    VirtualMemoryTable[Index].Length       = FixedPcdGet32 (PcdBootLogSize);
+    VirtualMemoryTable[Index].Attributes   = ARM_MEMORY_REGION_ATTRIBUTE_WRITE_BACK;
+    VirtualMemoryInfo[Index].Type          = RK3588_MEM_RESERVED_REGION;
+    VirtualMemoryInfo[Index++].Name        = L"Boot Log";
+  }
+
   // Variable Volume
   VirtualMemoryTable[Index].PhysicalBase = VariablesBase;
   VirtualMemoryTable[Index].VirtualBase  = VirtualMemoryTable[Index].PhysicalBase;
@@ -278,6 +278,16 @@ static CRU_CLOCK  Clocks[CLK_COUNT] = {
     CRU_CLKGATE_CON_OFFSET,
     CLK_SARADC_GATE
     ),
+  CRU_CLOCK_INIT (
+    CLK_TSADC,
+    CRU_BASE,
+    CRU_CLKSEL_CON_OFFSET,
+    CLK_TSADC_SEL,
+    CRU_CLKSEL_CON_OFFSET,
+    CLK_TSADC_DIV,
+    CRU_CLKGATE_CON_OFFSET,
+    CLK_TSADC_GATE
+    ),
 };
 
 static CRU_RESET  Resets[RESET_COUNT] = {
@@ -287,6 +297,18 @@ static CRU_RESET  Resets[RESET_COUNT] = {
     CRU_SOFTRST_CON_OFFSET,
     SRST_P_SARADC
     ),
+  CRU_RESET_INIT (
+    RESET_SRST_P_TSADC,
+    CRU_BASE,
+    CRU_SOFTRST_CON_OFFSET,
+    SRST_P_TSADC
+    ),
+  CRU_RESET_INIT (
+    RESET_SRST_TSADC,
+    CRU_BASE,
+    CRU_SOFTRST_CON_OFFSET,
+    SRST_TSADC
+    ),
 };
 
 /********************* Private Variable Definition ***************************/
@@ -433,6 +455,7 @@ HAL_CRU_ClkGetFreq (
       break;
 
     case CLK_SARADC:
+    case CLK_TSADC:
       if (HAL_CRU_ClkGetMux (clockId) == 1) {
         pRate = PLL_INPUT_OSC_RATE;
       } else {
@@ -576,6 +599,7 @@ HAL_CRU_ClkSetFreq (
       return error;
 
     case CLK_SARADC:
+    case CLK_TSADC:
       if (PLL_INPUT_OSC_RATE % rate == 0) {
         pRate = PLL_INPUT_OSC_RATE;
         mux   = 1;
@@ -20,6 +20,8 @@
 #include <Library/Rk3588Pcie.h>
 #include <Library/RockchipPlatformLib.h>
 #include <Library/Pcie30PhyLib.h>
+#include <Library/PerformanceLib.h>
+#include <Library/TimerLib.h>
 #include <Library/UefiBootServicesTableLib.h>
 #include <IndustryStandard/Pci.h>
 #include <VarStoreData.h>
@@ -91,6 +93,9 @@
 #define IATU_LWR_TARGET_ADDR_OFF    0x014
 #define IATU_UPPER_TARGET_ADDR_OFF  0x018
 
+#define IATU_ENABLE_POLL_INTERVAL_US  10
+#define IATU_ENABLE_TIMEOUT_US        10000
+
 BOOLEAN
 IsPcieNumEnabled (
   UINTN  PcieNum
@@ -419,16 +424,17 @@ PciEnableLtssm (
 STATIC
 BOOLEAN
 PciIsLinkUp (
-  IN EFI_PHYSICAL_ADDRESS  ApbBase
+  IN     UINT32                Segment,
+  IN     EFI_PHYSICAL_ADDRESS  ApbBase,
+  IN OUT UINT32                *LastVal
   )
 {
-  STATIC UINT32  LastVal = 0xFFFFFFFF;
-  UINT32         Val;
+  UINT32  Val;
 
   Val = MmioRead32 (ApbBase + PCIE_CLIENT_LTSSM_STATUS);
-  if (Val != LastVal) {
-    DEBUG ((DEBUG_INIT, "PCIe: PciIsLinkUp(): LTSSM_STATUS=0x%08X\n", Val));
-    LastVal = Val;
+  if (Val != *LastVal) {
+    DEBUG ((DEBUG_INIT, "PCIe %u: PciIsLinkUp(): LTSSM_STATUS=0x%08X\n", Segment, Val));
+    *LastVal = Val;
   }
 
   if ((Val & RDLH_LINK_UP) == 0) {
@@ -443,7 +449,7 @@ PciIsLinkUp (
 }
 
 STATIC
-VOID
+EFI_STATUS
 PciSetupAtu (
   IN EFI_PHYSICAL_ADDRESS  DbiBase,
   IN UINT32                Index,
@@ -454,6 +460,7 @@ PciSetupAtu (
   )
 {
   UINT32  Ctrl2Off = IATU_ENABLE;
+  UINT32  Retry;
 
   if ((Type == IATU_TYPE_CFG0) || (Type == IATU_TYPE_CFG1)) {
     Ctrl2Off |= IATU_CFG_SHIFT_MODE;
@@ -488,7 +495,19 @@ PciSetupAtu (
     Ctrl2Off
     );
 
-  gBS->Stall (10000);
+  //
+  // Make sure the window is enabled before it gets used.
+  //
+  for (Retry = IATU_ENABLE_TIMEOUT_US / IATU_ENABLE_POLL_INTERVAL_US; Retry != 0; Retry--) {
+    if ((MmioRead32 (DbiBase + IATU_REGION_CTRL_OUTBOUND (Index) + IATU_REGION_CTRL_2_OFF) & IATU_ENABLE) != 0) {
+      return EFI_SUCCESS;
+    }
+
+    gBS->Stall (IATU_ENABLE_POLL_INTERVAL_US);
+  }
+
+  DEBUG ((DEBUG_WARN, "PCIe: iATU window %u enable timeout!\n", Index));
+  return EFI_TIMEOUT;
 }
 
 STATIC
@@ -569,41 +588,105 @@ STATIC struct {
   },
 };
 
-EFI_STATUS
-InitializePciHost (
-  UINT32  Segment
+//
+// PERST# must stay asserted for at least 100 ms after power is stable
+// (PCIe CEM r4.0, section 2.9.2).
+//
+#define PCIE_POWER_STABLE_DELAY_US  100000
+#define PCIE_PERST_DELAY_US         100000
+
+#define PCIE_LINK_POLL_INTERVAL_US    100
+#define PCIE_LINK_UP_TIMEOUT_US       1000000
+#define PCIE_SPEED_CHANGE_TIMEOUT_US  50000
+
+typedef enum {
+  PcieHostStateTraining,
+  PcieHostStateSpeedChange,
+  PcieHostStateDone
+} PCIE_HOST_STATE;
+
+typedef struct {
+  EFI_PHYSICAL_ADDRESS    ApbBase;
+  EFI_PHYSICAL_ADDRESS    DbiBase;
+  EFI_PHYSICAL_ADDRESS    PcieBase;
+  UINT32                  LinkSpeed;
+  UINT32                  LinkWidth;
+  UINT32                  LtssmStatus;
+  PCIE_HOST_STATE         State;
+  //
+  // Performance counter values of the bring-up milestones.
+  //
+  UINT64                  PowerOnTime;
+  UINT64                  PowerGoodTime;
+  UINT64                  PerstAssertTime;
+  UINT64                  PerstDeassertTime;
+  UINT64                  LinkUpTime;
+  UINT64                  SpeedChangeTime;
+} PCIE_HOST_CONTEXT;
+
+#define PCIE_CFG0_BASE    SIZE_1MB
+#define PCIE_CFG0_SIZE    SIZE_64KB
+#define PCIE_CFG1_BASE    SIZE_2MB
+#define PCIE_CFG1_SIZE    (0x10000000UL - (SIZE_2MB + SIZE_64KB))
+#define PCIE_PCI_IO_BASE  0x2FFF0000UL
+#define PCIE_PCI_IO_SIZE  SIZE_64KB
+
+STATIC
+UINT64
+PciElapsedUs (
+  IN UINT64  StartTime,
+  IN UINT64  EndTime
   )
 {
-  EFI_PHYSICAL_ADDRESS  ApbBase  = PCIE_APB_BASE (Segment);
-  EFI_PHYSICAL_ADDRESS  DbiBase  = PCIE_DBI_BASE (Segment);
-  EFI_PHYSICAL_ADDRESS  PcieBase = PCIE_CFG_BASE (Segment);
-  EFI_STATUS            Status;
-  UINTN                 Retry;
-  UINT32                LinkSpeed;
-  UINT32                LinkWidth;
-  UINT64                Cfg0Base;
-  UINT64                Cfg0Size;
-  UINT64                Cfg1Base;
-  UINT64                Cfg1Size;
-  UINT64                PciIoBase;
-  UINT64                PciIoSize;
-  UINT8                 Pcie30PhyMode;
+  return GetTimeInNanoSecond (EndTime - StartTime) / 1000;
+}
 
-  Pcie30PhyMode = PcdGet8 (PcdPcie30PhyMode);
-  if (Pcie30PhyMode >= NUM_MODES) {
-    /* If one modified this to some strange value, this will make all things about to work */
-    DEBUG ((DEBUG_WARN, "PCIe: Invalid PCIe 3.0 PHY mode %u, use NANBNB(x2x2)\n", Pcie30PhyMode));
-    Pcie30PhyMode = PCIE30_PHY_MODE_NANBNB;
+STATIC
+VOID
+PciWaitUntil (
+  IN UINT64  StartTime,
+  IN UINT64  DelayUs
+  )
+{
+  while (PciElapsedUs (StartTime, GetPerformanceCounter ()) < DelayUs) {
+    gBS->Stall (PCIE_LINK_POLL_INTERVAL_US);
   }
+}
 
-  if (Segment >= NUM_SEGMENTS) {
-    DEBUG ((DEBUG_WARN, "PCIe: Invalid segment %u\n", Segment));
-    return EFI_INVALID_PARAMETER;
-  }
+STATIC
+VOID
+PciLogPerformance (
+  IN UINT32        Segment,
+  IN CONST CHAR8   *Name,
+  IN UINT64        StartTime,
+  IN UINT64        EndTime
+  )
+{
+  CHAR8  Token[16];
+
+  AsciiSPrint (Token, sizeof (Token), "PCIe%u %a", Segment, Name);
 
-  LinkSpeed = LinkSpeedWidthMap[Pcie30PhyMode][Segment].Speed;
-  LinkWidth = LinkSpeedWidthMap[Pcie30PhyMode][Segment].Width;
-  if ((LinkSpeed == 0) || (LinkWidth == 0)) {
+  PERF_START (NULL, Token, gEfiCallerBaseName, StartTime);
+  PERF_END (NULL, Token, gEfiCallerBaseName, EndTime);
+}
+
+STATIC
+EFI_STATUS
+PciPowerUpHost (
+  IN  UINT32             Segment,
+  IN  UINT8              Pcie30PhyMode,
+  OUT PCIE_HOST_CONTEXT  *Host
+  )
+{
+  Host->ApbBase     = PCIE_APB_BASE (Segment);
+  Host->DbiBase     = PCIE_DBI_BASE (Segment);
+  Host->PcieBase    = PCIE_CFG_BASE (Segment);
+  Host->LinkSpeed   = LinkSpeedWidthMap[Pcie30PhyMode][Segment].Speed;
+  Host->LinkWidth   = LinkSpeedWidthMap[Pcie30PhyMode][Segment].Width;
+  Host->LtssmStatus = 0xFFFFFFFF;
+  Host->State       = PcieHostStateTraining;
+
+  if ((Host->LinkSpeed == 0) || (Host->LinkWidth == 0)) {
     /* should never here */
     DEBUG ((DEBUG_WARN, "PCIe: Segment %u not enabled\n", Segment));
     return EFI_UNSUPPORTED;
@@ -611,88 +694,280 @@ InitializePciHost (
 
   /* Log settings */
   DEBUG ((DEBUG_INIT, "\nPCIe: Segment %u\n", Segment));
-  DEBUG ((DEBUG_INIT, "PCIe: PciExpressBaseAddress 0x%lx\n", PcieBase));
-  DEBUG ((DEBUG_INIT, "PCIe: ApbBase 0x%lx\n", ApbBase));
-  DEBUG ((DEBUG_INIT, "PCIe: DbiBase 0x%lx\n", DbiBase));
-  DEBUG ((DEBUG_INIT, "PCIe: NumLanes %u\n", LinkWidth));
-  DEBUG ((DEBUG_INIT, "PCIe: LinkSpeed %u\n", LinkSpeed));
+  DEBUG ((DEBUG_INIT, "PCIe: PciExpressBaseAddress 0x%lx\n", Host->PcieBase));
+  DEBUG ((DEBUG_INIT, "PCIe: ApbBase 0x%lx\n", Host->ApbBase));
+  DEBUG ((DEBUG_INIT, "PCIe: DbiBase 0x%lx\n", Host->DbiBase));
+  DEBUG ((DEBUG_INIT, "PCIe: NumLanes %u\n", Host->LinkWidth));
+  DEBUG ((DEBUG_INIT, "PCIe: LinkSpeed %u\n", Host->LinkSpeed));
 
   PcieIoInit (Segment);
   PciePowerEn (Segment, TRUE);
-  gBS->Stall (100000);
+  Host->PowerOnTime = GetPerformanceCounter ();
 
-  if ((Segment == PCIE_SEGMENT_PCIE30X4) || (Segment == PCIE_SEGMENT_PCIE30X2)) {
-    /* Configure PCIe 3.0 PHY */
-    Status = Pcie30PhyInit ();
-    if (EFI_ERROR (Status)) {
-      return Status;
-    }
-  }
+  return EFI_SUCCESS;
+}
 
-  /* Combo PHY for PCIe 2.0 is configured earlier by RK3588Dxe */
+STATIC
+EFI_STATUS
+PciSetupHost (
+  IN UINT32             Segment,
+  IN PCIE_HOST_CONTEXT  *Host
+  )
+{
+  EFI_STATUS            Status;
+  EFI_PHYSICAL_ADDRESS  DbiBase;
+
+  DbiBase = Host->DbiBase;
 
-  DEBUG ((DEBUG_INIT, "PCIe: Setup clocks\n"));
+  DEBUG ((DEBUG_INIT, "PCIe %u: Setup clocks\n", Segment));
   PciSetupClocks (Segment);
 
-  DEBUG ((DEBUG_INIT, "PCIe: Switching to RC mode\n"));
-  PciSetRcMode (Segment, ApbBase);
+  DEBUG ((DEBUG_INIT, "PCIe %u: Switching to RC mode\n", Segment));
+  PciSetRcMode (Segment, Host->ApbBase);
 
   /* Allow writing RO registers through the DBI */
-  DEBUG ((DEBUG_INIT, "PCIe: Enabling DBI access\n"));
+  DEBUG ((DEBUG_INIT, "PCIe %u: Enabling DBI access\n", Segment));
   MmioOr32 (DbiBase + PL_MISC_CONTROL_1_OFF, DBI_RO_WR_EN);
 
-  DEBUG ((DEBUG_INIT, "PCIe: Setup BARs\n"));
+  DEBUG ((DEBUG_INIT, "PCIe %u: Setup BARs\n", Segment));
   PciSetupBars (DbiBase);
 
-  DEBUG ((DEBUG_INIT, "PCIe: Setup iATU\n"));
-  Cfg0Base  = SIZE_1MB;
-  Cfg0Size  = SIZE_64KB;
-  Cfg1Base  = SIZE_2MB;
-  Cfg1Size  = 0x10000000UL - (SIZE_2MB + SIZE_64KB);
-  PciIoBase = 0x2FFF0000UL;
-  PciIoSize = SIZE_64KB;
+  DEBUG ((DEBUG_INIT, "PCIe %u: Setup iATU\n", Segment));
+  Status = PciSetupAtu (DbiBase, 0, IATU_TYPE_CFG0, Host->PcieBase + PCIE_CFG0_BASE, PCIE_CFG0_BASE, PCIE_CFG0_SIZE);
+  if (!EFI_ERROR (Status)) {
+    Status = PciSetupAtu (DbiBase, 1, IATU_TYPE_CFG1, Host->PcieBase + PCIE_CFG1_BASE, PCIE_CFG1_BASE, PCIE_CFG1_SIZE);
+  }
+
+  if (!EFI_ERROR (Status)) {
+    Status = PciSetupAtu (DbiBase, 2, IATU_TYPE_IO, Host->PcieBase + PCIE_PCI_IO_BASE, 0, PCIE_PCI_IO_SIZE);
+  }
 
-  PciSetupAtu (DbiBase, 0, IATU_TYPE_CFG0, PcieBase + Cfg0Base, Cfg0Base, Cfg0Size);
-  PciSetupAtu (DbiBase, 1, IATU_TYPE_CFG1, PcieBase + Cfg1Base, Cfg1Base, Cfg1Size);
-  PciSetupAtu (DbiBase, 2, IATU_TYPE_IO, PcieBase + PciIoBase, 0, PciIoSize);
+  if (EFI_ERROR (Status)) {
+    MmioAnd32 (DbiBase + PL_MISC_CONTROL_1_OFF, ~DBI_RO_WR_EN);
+    return Status;
+  }
 
-  DEBUG ((DEBUG_INIT, "PCIe: Set link speed\n"));
-  PciSetupLinkSpeed (DbiBase, LinkSpeed, LinkWidth);
+  DEBUG ((DEBUG_INIT, "PCIe %u: Set link speed\n", Segment));
+  PciSetupLinkSpeed (DbiBase, Host->LinkSpeed, Host->LinkWidth);
   PciDirectSpeedChange (DbiBase);
 
   /* Disallow writing RO registers through the DBI */
   MmioAnd32 (DbiBase + PL_MISC_CONTROL_1_OFF, ~DBI_RO_WR_EN);
 
-  DEBUG ((DEBUG_INIT, "PCIe: Assert reset\n"));
+  DEBUG ((DEBUG_INIT, "PCIe %u: Assert reset\n", Segment));
   PciePeReset (Segment, TRUE);
+  Host->PerstAssertTime = GetPerformanceCounter ();
 
-  DEBUG ((DEBUG_INIT, "PCIe: Start LTSSM\n"));
+  DEBUG ((DEBUG_INIT, "PCIe %u: Start LTSSM\n", Segment));
+  PciEnableLtssm (Host->ApbBase, TRUE);
 
-  PciEnableLtssm (ApbBase, TRUE);
+  return EFI_SUCCESS;
+}
 
-  gBS->Stall (100000);
-  DEBUG ((DEBUG_INIT, "PCIe: Deassert reset\n"));
-  PciePeReset (Segment, FALSE);
+/**
+  Advance the link state machine of a root port.
 
-  /* Wait for link up */
-  DEBUG ((DEBUG_INIT, "PCIe: Waiting for link up...\n"));
-  for (Retry = 10; Retry != 0; Retry--) {
-    if (PciIsLinkUp (ApbBase)) {
-      break;
+  @param[in]  Segment   The segment number.
+  @param[in]  Host      The root port context.
+  @param[in]  Now       The current performance counter value.
+
+  @retval EFI_NOT_READY   The link is still being brought up.
+  @retval EFI_SUCCESS     The link is up and running at its final speed.
+  @retval EFI_TIMEOUT     The link didn't come up in time.
+
+**/
+STATIC
+EFI_STATUS
+PciPollHost (
+  IN UINT32             Segment,
+  IN PCIE_HOST_CONTEXT  *Host,
+  IN UINT64             Now
+  )
+{
+  UINT32  Speed;
+  UINT32  Width;
+
+  switch (Host->State) {
+    case PcieHostStateTraining:
+      if (!PciIsLinkUp (Segment, Host->ApbBase, &Host->LtssmStatus)) {
+        if (PciElapsedUs (Host->PerstDeassertTime, Now) >= PCIE_LINK_UP_TIMEOUT_US) {
+          DEBUG ((DEBUG_WARN, "PCIe %u: Link up timeout!\n", Segment));
+          return EFI_TIMEOUT;
+        }
+
+        return EFI_NOT_READY;
+      }
+
+      Host->LinkUpTime = Now;
+      Host->State      = PcieHostStateSpeedChange;
+      //
+      // Fall through
+      //
+    case PcieHostStateSpeedChange:
+      //
+      // The link comes up at 2.5 GT/s first and then retrains to the target
+      // speed. Endpoints that can't go faster stay where they are, so
+      // give up waiting after a while.
+      //
+      PciGetLinkSpeedWidth (Host->DbiBase, &Speed, &Width);
+      if ((Speed < Host->LinkSpeed) &&
+          (PciElapsedUs (Host->LinkUpTime, Now) < PCIE_SPEED_CHANGE_TIMEOUT_US))
+      {
+        return EFI_NOT_READY;
+      }
+
+      Host->SpeedChangeTime = Now;
+      Host->LinkSpeed       = Speed;
+      Host->LinkWidth       = Width;
+      Host->State           = PcieHostStateDone;
+      return EFI_SUCCESS;
+
+    default:
+      return EFI_SUCCESS;
+  }
+}
+
+/**
+  Bring up all enabled PCIe root ports.
+
+  The controllers are brought up in phases, so that the power-up, reset and
+  link training delays of all segments overlap instead of adding up.
+
+  @param[out] Status    The result for each segment. EFI_NOT_STARTED is
+                        returned for disabled segments.
+
+**/
+VOID
+InitializePciHosts (
+  OUT EFI_STATUS  Status[NUM_PCIE_CONTROLLER]
+  )
+{
+  PCIE_HOST_CONTEXT  Hosts[NUM_PCIE_CONTROLLER];
+  PCIE_HOST_CONTEXT  *Host;
+  UINT32             Segment;
+  UINT32             Pending;
+  UINT8              Pcie30PhyMode;
+  BOOLEAN            Pcie30PhyReady;
+  EFI_STATUS         PhyStatus;
+
+  Pcie30PhyMode = PcdGet8 (PcdPcie30PhyMode);
+  if (Pcie30PhyMode >= NUM_MODES) {
+    /* If one modified this to some strange value, this will make all things about to work */
+    DEBUG ((DEBUG_WARN, "PCIe: Invalid PCIe 3.0 PHY mode %u, use NANBNB(x2x2)\n", Pcie30PhyMode));
+    Pcie30PhyMode = PCIE30_PHY_MODE_NANBNB;
+  }
+
+  //
+  // Power up all enabled segments.
+  //
+  Pending = 0;
+  for (Segment = 0; Segment < NUM_PCIE_CONTROLLER; Segment++) {
+    Status[Segment] = EFI_NOT_STARTED;
+
+    if (!IsPcieNumEnabled (Segment)) {
+      continue;
     }
 
-    gBS->Stall (100000);
+    Status[Segment] = PciPowerUpHost (Segment, Pcie30PhyMode, &Hosts[Segment]);
+    if (!EFI_ERROR (Status[Segment])) {
+      Pending |= 1 << Segment;
+    }
   }
 
-  if (Retry == 0) {
-    DEBUG ((DEBUG_WARN, "PCIe: Link up timeout!\n"));
-    return EFI_TIMEOUT;
+  //
+  // Configure the controllers and start link training with PERST# asserted,
+  // each as soon as its power is stable.
+  //
+  Pcie30PhyReady = FALSE;
+  for (Segment = 0; Segment < NUM_PCIE_CONTROLLER; Segment++) {
+    if ((Pending & (1 << Segment)) == 0) {
+      continue;
+    }
+
+    Host = &Hosts[Segment];
+    PciWaitUntil (Host->PowerOnTime, PCIE_POWER_STABLE_DELAY_US);
+    Host->PowerGoodTime = GetPerformanceCounter ();
+
+    if ((Segment == PCIE_SEGMENT_PCIE30X4) || (Segment == PCIE_SEGMENT_PCIE30X2)) {
+      //
+      // Both PCIe 3.0 controllers share the same PHY.
+      //
+      if (!Pcie30PhyReady) {
+        PhyStatus = Pcie30PhyInit ();
+        if (EFI_ERROR (PhyStatus)) {
+          Status[Segment] = PhyStatus;
+          Pending        &= ~(1 << Segment);
+          continue;
+        }
+
+        Pcie30PhyReady = TRUE;
+      }
+    }
+
+    /* Combo PHY for PCIe 2.0 is configured earlier by RK3588Dxe */
+
+    Status[Segment] = PciSetupHost (Segment, Host);
+    if (EFI_ERROR (Status[Segment])) {
+      DEBUG ((DEBUG_ERROR, "PCIe %u: Host setup failed. Status=%r\n", Segment, Status[Segment]));
+      Pending &= ~(1 << Segment);
+    }
   }
 
-  PciGetLinkSpeedWidth (DbiBase, &LinkSpeed, &LinkWidth);
-  PciPrintLinkSpeedWidth (LinkSpeed, LinkWidth);
+  for (Segment = 0; Segment < NUM_PCIE_CONTROLLER; Segment++) {
+    if ((Pending & (1 << Segment)) == 0) {
+      continue;
+    }
 
-  PciValidateCfg0 (Segment, PcieBase + Cfg0Base);
+    Host = &Hosts[Segment];
+    PciWaitUntil (Host->PerstAssertTime, PCIE_PERST_DELAY_US);
 
-  return EFI_SUCCESS;
+    DEBUG ((DEBUG_INIT, "PCIe %u: Deassert reset\n", Segment));
+    PciePeReset (Segment, FALSE);
+    Host->PerstDeassertTime = GetPerformanceCounter ();
+  }
+
+  //
+  // Wait for all links to come up.
+  //
+  DEBUG ((DEBUG_INIT, "PCIe: Waiting for link up...\n"));
+  while (Pending != 0) {
+    for (Segment = 0; Segment < NUM_PCIE_CONTROLLER; Segment++) {
+      if ((Pending & (1 << Segment)) == 0) {
+        continue;
+      }
+
+      Host            = &Hosts[Segment];
+      Status[Segment] = PciPollHost (Segment, Host, GetPerformanceCounter ());
+      if (Status[Segment] == EFI_NOT_READY) {
+        continue;
+      }
+
+      Pending &= ~(1 << Segment);
+
+      PciLogPerformance (Segment, "Power", Host->PowerOnTime, Host->PowerGoodTime);
+      if (EFI_ERROR (Status[Segment])) {
+        continue;
+      }
+
+      PciLogPerformance (Segment, "LinkUp", Host->PerstDeassertTime, Host->LinkUpTime);
+      PciLogPerformance (Segment, "Speed", Host->LinkUpTime, Host->SpeedChangeTime);
+
+      DEBUG ((
+        DEBUG_INIT,
+        "PCIe %u: Power good in %lu ms, link up in %lu ms, speed change in %lu ms\n",
+        Segment,
+        PciElapsedUs (Host->PowerOnTime, Host->PowerGoodTime) / 1000,
+        PciElapsedUs (Host->PerstDeassertTime, Host->LinkUpTime) / 1000,
+        PciElapsedUs (Host->LinkUpTime, Host->SpeedChangeTime) / 1000
+        ));
+
+      PciPrintLinkSpeedWidth (Host->LinkSpeed, Host->LinkWidth);
+
+      PciValidateCfg0 (Segment, Host->PcieBase + PCIE_CFG0_BASE);
+    }
+
+    if (Pending != 0) {
+      gBS->Stall (PCIE_LINK_POLL_INTERVAL_US);
+    }
+  }
 }
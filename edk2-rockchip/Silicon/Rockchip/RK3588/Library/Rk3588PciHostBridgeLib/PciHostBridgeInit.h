@@ -10,9 +10,9 @@
 #ifndef PCIHOSTBRIDGEINIT_H__
 #define PCIHOSTBRIDGEINIT_H__
 
-EFI_STATUS
-InitializePciHost (
-  UINT32  Segment
+VOID
+InitializePciHosts (
+  OUT EFI_STATUS  Status[NUM_PCIE_CONTROLLER]
   );
 
 #endif /* PCIHOSTBRIDGEINIT_H__ */
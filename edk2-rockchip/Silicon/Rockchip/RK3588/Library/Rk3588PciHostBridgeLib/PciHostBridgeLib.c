@@ -163,17 +163,14 @@ PciHostBridgeGetRootBridges (
   UINTN  *Count
   )
 {
-  EFI_STATUS  Status;
+  EFI_STATUS  Status[NUM_PCIE_CONTROLLER];
   UINTN       Idx;
   UINTN       Loop;
 
-  for (Idx = 0, Loop = 0; Idx < NUM_PCIE_CONTROLLER; Idx++) {
-    if (IsPcieNumEnabled (Idx) == FALSE) {
-      continue;
-    }
+  InitializePciHosts (Status);
 
-    Status = InitializePciHost (Idx);
-    if (EFI_ERROR (Status)) {
+  for (Idx = 0, Loop = 0; Idx < NUM_PCIE_CONTROLLER; Idx++) {
+    if (EFI_ERROR (Status[Idx])) {
       continue;
     }
 
@@ -14,17 +14,11 @@
 
 #include <Library/PciSegmentLib.h>
 #include <Library/BaseLib.h>
+#include <Library/BaseMemoryLib.h>
 #include <Library/DebugLib.h>
 #include <Library/IoLib.h>
 #include <Library/Rk3588Pcie.h>
 
-typedef enum {
-  PciCfgWidthUint8 = 0,
-  PciCfgWidthUint16,
-  PciCfgWidthUint32,
-  PciCfgWidthMax
-} PCI_CFG_WIDTH;
-
 /**
   Assert the validity of a PCI Segment address.
   A valid PCI Segment address should not contain 1's in bits 28..31 and 48..63
@@ -42,9 +36,30 @@ typedef enum {
 #define GET_FUNC_NUM(Address)  ((Address >> 12) & 0x07)
 #define GET_REG_NUM(Address)   ((Address) & 0xFFF)
 
+//
+// Config space bases of each segment, indexed by whether the bus is behind
+// the root port. The root port itself is only reachable through the DBI.
+//
+STATIC CONST UINT64  mPciSegmentConfigBase[NUM_PCIE_CONTROLLER][2] = {
+  { PCIE_DBI_BASE (0), PCIE_CFG_BASE (0) },
+  { PCIE_DBI_BASE (1), PCIE_CFG_BASE (1) },
+  { PCIE_DBI_BASE (2), PCIE_CFG_BASE (2) },
+  { PCIE_DBI_BASE (3), PCIE_CFG_BASE (3) },
+  { PCIE_DBI_BASE (4), PCIE_CFG_BASE (4) },
+};
+
+/**
+  Get the MMIO address of a PCI configuration register.
+
+  @param  Address The address that encodes the PCI Segment, Bus, Device,
+                  Function and Register.
+
+  @return The MMIO address of the register, or 0 if the device must be hidden.
+
+**/
 STATIC
-UINT64
-PciSegmentLibGetConfigBase (
+UINTN
+PciSegmentLibGetConfigAddress (
   IN  UINT64  Address
   )
 {
@@ -58,110 +73,13 @@ PciSegmentLibGetConfigBase (
 
   ASSERT (Segment < NUM_PCIE_CONTROLLER);
 
-  // DEBUG ((DEBUG_ERROR, "PciSegmentLibGetConfigBase: Address=0x%lX, Bus=%d, Segment=%d\n",
-  //         Address, Bus, Segment));
-
   // Ignore more than one device on bus 0 and 1 to hide duplicates/ghosts.
-  if ((Device > 0) && ((Bus == 0) || (Bus == 1))) {
-    return 0xffffffff;
-  }
-
-  // The root port is not part of the main config space.
-  if (Bus == 0) {
-    return PCIE_DBI_BASE (Segment);
-  }
-
-  // Here starts the not-quite-compliant ECAM space.
-  return PCIE_CFG_BASE (Segment);
-}
-
-/**
-  Internal worker function to read a PCI configuration register.
-
-  @param  Address The address that encodes the PCI Bus, Device, Function and
-                  Register.
-  @param  Width   The width of data to read
-
-  @return The value read from the PCI configuration register.
-
-**/
-STATIC
-UINT32
-PciSegmentLibReadWorker (
-  IN  UINT64         Address,
-  IN  PCI_CFG_WIDTH  Width
-  )
-{
-  UINT64  Base;
-
-  Base = PciSegmentLibGetConfigBase (Address);
-
-  if (Base == 0xFFFFFFFF) {
-    return Base;
-  }
-
-  // DEBUG ((DEBUG_ERROR, "PciSegmentLibReadWorker: Address=0x%lX, Base=0x%lX, Width=%u\n",
-  //         Address, Base, Width));
-
-  switch (Width) {
-    case PciCfgWidthUint8:
-      return MmioRead8 (Base + (UINT32)Address);
-    case PciCfgWidthUint16:
-      return MmioRead16 (Base + (UINT32)Address);
-    case PciCfgWidthUint32:
-      return MmioRead32 (Base + (UINT32)Address);
-    default:
-      ASSERT (FALSE);
-  }
-
-  return 0;
-}
-
-/**
-  Internal worker function to writes a PCI configuration register.
-
-  @param  Address The address that encodes the PCI Bus, Device, Function and
-                  Register.
-  @param  Width   The width of data to write
-  @param  Data    The value to write.
-
-  @return The value written to the PCI configuration register.
-
-**/
-STATIC
-UINT32
-PciSegmentLibWriteWorker (
-  IN  UINT64         Address,
-  IN  PCI_CFG_WIDTH  Width,
-  IN  UINT32         Data
-  )
-{
-  UINT64  Base;
-
-  Base = PciSegmentLibGetConfigBase (Address);
-
-  if (Base == 0xFFFFFFFF) {
-    return Base;
-  }
-
-  // DEBUG ((DEBUG_ERROR, "PciSegmentLibWriteWorker: Address=0x%lX, Base=0x%lX, Width=%u\n",
-  //       Address, Base, Width));
-
-  switch (Width) {
-    case PciCfgWidthUint8:
-      MmioWrite8 (Base + (UINT32)Address, Data);
-      break;
-    case PciCfgWidthUint16:
-      MmioWrite16 (Base + (UINT32)Address, Data);
-      break;
-    case PciCfgWidthUint32:
-      MmioWrite32 (Base + (UINT32)Address, Data);
-      break;
-    default:
-      ASSERT (FALSE);
+  if ((Device > 0) && (Bus <= 1)) {
+    return 0;
   }
 
-  return Data;
+  // Bus 0 is the root port, the rest is the not-quite-compliant ECAM space.
+  return (UINTN)(mPciSegmentConfigBase[Segment][Bus != 0] + (UINT32)Address);
 }
 
 /**
@@ -212,9 +130,16 @@ PciSegmentRead8 (
   IN UINT64  Address
   )
 {
+  UINTN  ConfigAddress;
+
   ASSERT_INVALID_PCI_SEGMENT_ADDRESS (Address, 0);
 
-  return (UINT8)PciSegmentLibReadWorker (Address, PciCfgWidthUint8);
+  ConfigAddress = PciSegmentLibGetConfigAddress (Address);
+  if (ConfigAddress == 0) {
+    return MAX_UINT8;
+  }
+
+  return MmioRead8 (ConfigAddress);
 }
 
 /**
@@ -238,9 +163,16 @@ PciSegmentWrite8 (
   IN UINT8   Value
   )
 {
+  UINTN  ConfigAddress;
+
   ASSERT_INVALID_PCI_SEGMENT_ADDRESS (Address, 0);
 
-  return (UINT8)PciSegmentLibWriteWorker (Address, PciCfgWidthUint8, Value);
+  ConfigAddress = PciSegmentLibGetConfigAddress (Address);
+  if (ConfigAddress == 0) {
+    return Value;
+  }
+
+  return MmioWrite8 (ConfigAddress, Value);
 }
 
 /**
@@ -549,9 +481,16 @@ PciSegmentRead16 (
   IN UINT64  Address
   )
 {
+  UINTN  ConfigAddress;
+
   ASSERT_INVALID_PCI_SEGMENT_ADDRESS (Address, 1);
 
-  return (UINT16)PciSegmentLibReadWorker (Address, PciCfgWidthUint16);
+  ConfigAddress = PciSegmentLibGetConfigAddress (Address);
+  if (ConfigAddress == 0) {
+    return MAX_UINT16;
+  }
+
+  return MmioRead16 (ConfigAddress);
 }
 
 /**
@@ -576,9 +515,16 @@ PciSegmentWrite16 (
   IN UINT16  Value
   )
 {
+  UINTN  ConfigAddress;
+
   ASSERT_INVALID_PCI_SEGMENT_ADDRESS (Address, 1);
 
-  return (UINT16)PciSegmentLibWriteWorker (Address, PciCfgWidthUint16, Value);
+  ConfigAddress = PciSegmentLibGetConfigAddress (Address);
+  if (ConfigAddress == 0) {
+    return Value;
+  }
+
+  return MmioWrite16 (ConfigAddress, Value);
 }
 
 /**
@@ -893,9 +839,16 @@ PciSegmentRead32 (
   IN UINT64  Address
   )
 {
+  UINTN  ConfigAddress;
+
   ASSERT_INVALID_PCI_SEGMENT_ADDRESS (Address, 3);
 
-  return PciSegmentLibReadWorker (Address, PciCfgWidthUint32);
+  ConfigAddress = PciSegmentLibGetConfigAddress (Address);
+  if (ConfigAddress == 0) {
+    return MAX_UINT32;
+  }
+
+  return MmioRead32 (ConfigAddress);
 }
 
 /**
@@ -921,9 +874,16 @@ PciSegmentWrite32 (
   IN UINT32  Value
   )
 {
+  UINTN  ConfigAddress;
+
   ASSERT_INVALID_PCI_SEGMENT_ADDRESS (Address, 3);
 
-  return PciSegmentLibWriteWorker (Address, PciCfgWidthUint32, Value);
+  ConfigAddress = PciSegmentLibGetConfigAddress (Address);
+  if (ConfigAddress == 0) {
+    return Value;
+  }
+
+  return MmioWrite32 (ConfigAddress, Value);
 }
 
 /**
@@ -1252,6 +1212,7 @@ PciSegmentReadBuffer (
   )
 {
   UINTN  ReturnValue;
+  UINTN  ConfigAddress;
 
   ASSERT_INVALID_PCI_SEGMENT_ADDRESS (StartAddress, 0);
   ASSERT (((StartAddress & 0xFFF) + Size) <= 0x1000);
@@ -1267,51 +1228,60 @@ PciSegmentReadBuffer (
   //
   ReturnValue = Size;
 
-  if ((StartAddress & BIT0) != 0) {
+  //
+  // The whole range belongs to a single function, so resolve it only once.
+  //
+  ConfigAddress = PciSegmentLibGetConfigAddress (StartAddress);
+  if (ConfigAddress == 0) {
+    SetMem (Buffer, Size, 0xFF);
+    return ReturnValue;
+  }
+
+  if ((ConfigAddress & BIT0) != 0) {
     //
     // Read a byte if StartAddress is byte aligned
     //
-    *(volatile UINT8 *)Buffer = PciSegmentRead8 (StartAddress);
-    StartAddress             += sizeof (UINT8);
+    *(volatile UINT8 *)Buffer = MmioRead8 (ConfigAddress);
+    ConfigAddress            += sizeof (UINT8);
     Size                     -= sizeof (UINT8);
     Buffer                    = (UINT8 *)Buffer + 1;
   }
 
-  if ((Size >= sizeof (UINT16)) && ((StartAddress & BIT1) != 0)) {
+  if ((Size >= sizeof (UINT16)) && ((ConfigAddress & BIT1) != 0)) {
     //
     // Read a word if StartAddress is word aligned
     //
-    WriteUnaligned16 (Buffer, PciSegmentRead16 (StartAddress));
-    StartAddress += sizeof (UINT16);
-    Size         -= sizeof (UINT16);
-    Buffer        = (UINT16 *)Buffer + 1;
+    WriteUnaligned16 (Buffer, MmioRead16 (ConfigAddress));
+    ConfigAddress += sizeof (UINT16);
+    Size          -= sizeof (UINT16);
+    Buffer         = (UINT16 *)Buffer + 1;
   }
 
   while (Size >= sizeof (UINT32)) {
     //
     // Read as many double words as possible
     //
-    WriteUnaligned32 (Buffer, PciSegmentRead32 (StartAddress));
-    StartAddress += sizeof (UINT32);
-    Size         -= sizeof (UINT32);
-    Buffer        = (UINT32 *)Buffer + 1;
+    WriteUnaligned32 (Buffer, MmioRead32 (ConfigAddress));
+    ConfigAddress += sizeof (UINT32);
+    Size          -= sizeof (UINT32);
+    Buffer         = (UINT32 *)Buffer + 1;
   }
 
   if (Size >= sizeof (UINT16)) {
     //
     // Read the last remaining word if exist
     //
-    WriteUnaligned16 (Buffer, PciSegmentRead16 (StartAddress));
-    StartAddress += sizeof (UINT16);
-    Size         -= sizeof (UINT16);
-    Buffer        = (UINT16 *)Buffer + 1;
+    WriteUnaligned16 (Buffer, MmioRead16 (ConfigAddress));
+    ConfigAddress += sizeof (UINT16);
+    Size          -= sizeof (UINT16);
+    Buffer         = (UINT16 *)Buffer + 1;
   }
 
   if (Size >= sizeof (UINT8)) {
     //
     // Read the last remaining byte if exist
     //
-    *(volatile UINT8 *)Buffer = PciSegmentRead8 (StartAddress);
+    *(volatile UINT8 *)Buffer = MmioRead8 (ConfigAddress);
   }
 
   return ReturnValue;
@@ -1350,6 +1320,7 @@ PciSegmentWriteBuffer (
   )
 {
   UINTN  ReturnValue;
+  UINTN  ConfigAddress;
 
   ASSERT_INVALID_PCI_SEGMENT_ADDRESS (StartAddress, 0);
   ASSERT (((StartAddress & 0xFFF) + Size) <= 0x1000);
@@ -1365,51 +1336,59 @@ PciSegmentWriteBuffer (
   //
   ReturnValue = Size;
 
-  if ((StartAddress & BIT0) != 0) {
+  //
+  // The whole range belongs to a single function, so resolve it only once.
+  //
+  ConfigAddress = PciSegmentLibGetConfigAddress (StartAddress);
+  if (ConfigAddress == 0) {
+    return ReturnValue;
+  }
+
+  if ((ConfigAddress & BIT0) != 0) {
     //
     // Write a byte if StartAddress is byte aligned
     //
-    PciSegmentWrite8 (StartAddress, *(UINT8 *)Buffer);
-    StartAddress += sizeof (UINT8);
-    Size         -= sizeof (UINT8);
-    Buffer        = (UINT8 *)Buffer + 1;
+    MmioWrite8 (ConfigAddress, *(UINT8 *)Buffer);
+    ConfigAddress += sizeof (UINT8);
+    Size          -= sizeof (UINT8);
+    Buffer         = (UINT8 *)Buffer + 1;
   }
 
-  if ((Size >= sizeof (UINT16)) && ((StartAddress & BIT1) != 0)) {
+  if ((Size >= sizeof (UINT16)) && ((ConfigAddress & BIT1) != 0)) {
     //
     // Write a word if StartAddress is word aligned
     //
-    PciSegmentWrite16 (StartAddress, ReadUnaligned16 (Buffer));
-    StartAddress += sizeof (UINT16);
-    Size         -= sizeof (UINT16);
-    Buffer        = (UINT16 *)Buffer + 1;
+    MmioWrite16 (ConfigAddress, ReadUnaligned16 (Buffer));
+    ConfigAddress += sizeof (UINT16);
+    Size          -= sizeof (UINT16);
+    Buffer         = (UINT16 *)Buffer + 1;
   }
 
   while (Size >= sizeof (UINT32)) {
     //
     // Write as many double words as possible
     //
-    PciSegmentWrite32 (StartAddress, ReadUnaligned32 (Buffer));
-    StartAddress += sizeof (UINT32);
-    Size         -= sizeof (UINT32);
-    Buffer        = (UINT32 *)Buffer + 1;
+    MmioWrite32 (ConfigAddress, ReadUnaligned32 (Buffer));
+    ConfigAddress += sizeof (UINT32);
+    Size          -= sizeof (UINT32);
+    Buffer         = (UINT32 *)Buffer + 1;
   }
 
   if (Size >= sizeof (UINT16)) {
     //
     // Write the last remaining word if exist
     //
-    PciSegmentWrite16 (StartAddress, ReadUnaligned16 (Buffer));
-    StartAddress += sizeof (UINT16);
-    Size         -= sizeof (UINT16);
-    Buffer        = (UINT16 *)Buffer + 1;
+    MmioWrite16 (ConfigAddress, ReadUnaligned16 (Buffer));
+    ConfigAddress += sizeof (UINT16);
+    Size          -= sizeof (UINT16);
+    Buffer         = (UINT16 *)Buffer + 1;
   }
 
   if (Size >= sizeof (UINT8)) {
     //
     // Write the last remaining byte if exist
     //
-    PciSegmentWrite8 (StartAddress, *(UINT8 *)Buffer);
+    MmioWrite8 (ConfigAddress, *(UINT8 *)Buffer);
   }
 
   return ReturnValue;
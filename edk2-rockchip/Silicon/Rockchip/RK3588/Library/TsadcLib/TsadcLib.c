@@ -0,0 +1,182 @@
+/** @file
+ *
+ *  Copyright (c) 2026, agent <agent@local>
+ *
+ *  SPDX-License-Identifier: BSD-2-Clause-Patent
+ *
+ **/
+
+#include <Library/BaseLib.h>
+#include <Library/CruLib.h>
+#include <Library/DebugLib.h>
+#include <Library/IoLib.h>
+#include <Library/TsadcLib.h>
+#include <Library/TimerLib.h>
+
+#define TSADC_BASE  0xfec00000
+
+#define TSADC_CLOCK_RATE     2000000
+#define TSADC_CHANNEL_COUNT  7
+#define TSADC_DATA_MASK      0x1ff
+
+//
+// 2.5 ms between samples, at TSADC_CLOCK_RATE.
+//
+#define TSADC_AUTO_PERIOD_TIME  5000
+#define TSADC_DEBOUNCE_COUNT    4
+
+#define TSADC_AUTO_CON              0x0004
+#define  TSADC_AUTO_EN              BIT0
+#define  TSADC_AUTO_TSHUT_POLARITY  BIT8
+#define TSADC_AUTO_SRC_CON          0x000C
+#define TSADC_DATA_BASE             0x002C
+#define TSADC_HIGHT_INT_DEBOUNCE    0x014C
+#define TSADC_HIGHT_TSHUT_DEBOUNCE  0x0150
+#define TSADC_AUTO_PERIOD           0x0154
+#define TSADC_AUTO_PERIOD_HT        0x0158
+
+#define WRITE_ENABLE_SHIFT  16
+
+typedef struct {
+  UINT32    Code;
+  INT32     Temperature;
+} TSADC_CODE_ENTRY;
+
+//
+// Code to millidegrees Celsius, linear in between the points.
+//
+STATIC CONST TSADC_CODE_ENTRY  mCodeTable[] = {
+  { 0,               -40000 },
+  { 215,             -40000 },
+  { 285,             25000  },
+  { 350,             85000  },
+  { 395,             125000 },
+  { TSADC_DATA_MASK, 125000 },
+};
+
+STATIC
+VOID
+TsadcReset (
+  VOID
+  )
+{
+  HAL_CRU_RstAssert (RESET_SRST_P_TSADC);
+  HAL_CRU_RstAssert (RESET_SRST_TSADC);
+  MicroSecondDelay (10);
+  HAL_CRU_RstDeassert (RESET_SRST_TSADC);
+  HAL_CRU_RstDeassert (RESET_SRST_P_TSADC);
+}
+
+STATIC
+VOID
+TsadcInit (
+  VOID
+  )
+{
+  UINT32  Channel;
+  UINT32  Value;
+
+  TsadcReset ();
+
+  MmioWrite32 (TSADC_BASE + TSADC_AUTO_PERIOD, TSADC_AUTO_PERIOD_TIME);
+  MmioWrite32 (TSADC_BASE + TSADC_AUTO_PERIOD_HT, TSADC_AUTO_PERIOD_TIME);
+  MmioWrite32 (TSADC_BASE + TSADC_HIGHT_INT_DEBOUNCE, TSADC_DEBOUNCE_COUNT);
+  MmioWrite32 (TSADC_BASE + TSADC_HIGHT_TSHUT_DEBOUNCE, TSADC_DEBOUNCE_COUNT);
+
+  //
+  // Low-active TSHUT output. Neither the GPIO nor the CRU shutdown
+  // interrupts get enabled, this only runs the sensors.
+  //
+  MmioWrite32 (TSADC_BASE + TSADC_AUTO_CON, TSADC_AUTO_TSHUT_POLARITY << WRITE_ENABLE_SHIFT);
+
+  for (Channel = 0; Channel < TSADC_CHANNEL_COUNT; Channel++) {
+    Value = 1 << Channel;
+    MmioWrite32 (TSADC_BASE + TSADC_AUTO_SRC_CON, (Value << WRITE_ENABLE_SHIFT) | Value);
+  }
+
+  Value = TSADC_AUTO_EN;
+  MmioWrite32 (TSADC_BASE + TSADC_AUTO_CON, (Value << WRITE_ENABLE_SHIFT) | Value);
+}
+
+STATIC
+INT32
+TsadcCodeToTemperature (
+  IN UINT32  Code
+  )
+{
+  UINTN                   Index;
+  CONST TSADC_CODE_ENTRY  *Low;
+  CONST TSADC_CODE_ENTRY  *High;
+
+  for (Index = 1; Index < ARRAY_SIZE (mCodeTable) - 1; Index++) {
+    if (Code < mCodeTable[Index].Code) {
+      break;
+    }
+  }
+
+  Low  = &mCodeTable[Index - 1];
+  High = &mCodeTable[Index];
+
+  if (Code >= High->Code) {
+    return High->Temperature;
+  }
+
+  return Low->Temperature +
+         (INT32)(Code - Low->Code) * (High->Temperature - Low->Temperature) /
+         (INT32)(High->Code - Low->Code);
+}
+
+UINT32
+TsadcGetChannelCount (
+  VOID
+  )
+{
+  return TSADC_CHANNEL_COUNT;
+}
+
+RETURN_STATUS
+TsadcReadTemperature (
+  IN  UINT32  Channel,
+  OUT INT32   *Temperature
+  )
+{
+  UINT32  Code;
+
+  if ((Channel >= TSADC_CHANNEL_COUNT) || (Temperature == NULL)) {
+    ASSERT (FALSE);
+    return RETURN_INVALID_PARAMETER;
+  }
+
+  Code  = MmioRead32 (TSADC_BASE + TSADC_DATA_BASE + (Channel * sizeof (UINT32)));
+  Code &= TSADC_DATA_MASK;
+
+  //
+  // Nothing sampled yet.
+  //
+  if (Code == 0) {
+    return RETURN_NOT_READY;
+  }
+
+  *Temperature = TsadcCodeToTemperature (Code);
+
+  return RETURN_SUCCESS;
+}
+
+RETURN_STATUS
+EFIAPI
+TsadcLibConstructor (
+  VOID
+  )
+{
+  if (MmioRead32 (TSADC_BASE + TSADC_AUTO_CON) & TSADC_AUTO_EN) {
+    return RETURN_SUCCESS;
+  }
+
+  if (HAL_CRU_ClkGetFreq (CLK_TSADC) != TSADC_CLOCK_RATE) {
+    HAL_CRU_ClkSetFreq (CLK_TSADC, TSADC_CLOCK_RATE);
+  }
+
+  TsadcInit ();
+
+  return RETURN_SUCCESS;
+}
@@ -202,6 +202,7 @@ Done:
     }
 
     if ((!InfiniteWait) && (Trb->Timeout-- == 0)) {
+      DwMmcStopTrbDma (Private, Trb);
       RemoveEntryList (Link);
       Trb->Packet->TransactionStatus = EFI_TIMEOUT;
       TrbEvent                       = Trb->Event;
@@ -683,6 +684,12 @@ DwMmcHcDriverBindingStart (
   Private->Slot[0].CardType = Private->Capability[0].CardType;
   Private->Slot[0].Enable   = TRUE;
 
+  Status = DwMmcHcAllocDmaDescRing (Private);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "%a: Failed to allocate DMA descriptors. Status=%r\n", __func__, Status));
+    goto Done;
+  }
+
   RoutineNum = sizeof (mCardTypeDetectRoutineTable) / sizeof (DWMMC_CARD_TYPE_DETECT_ROUTINE);
   for (Index = 0; Index < RoutineNum; Index++) {
     Routine = &mCardTypeDetectRoutineTable[Index];
@@ -752,6 +759,7 @@ Done:
     }
 
     if (Private != NULL) {
+      DwMmcHcFreeDmaDescRing (Private);
       FreePool (Private);
     }
   }
@@ -871,6 +879,7 @@ DwMmcHcDriverBindingStop (
          Controller
          );
 
+  DwMmcHcFreeDmaDescRing (Private);
   FreePool (Private);
 
   DEBUG ((DEBUG_INFO, "DwMmcHcDriverBindingStop: End with %r\n", Status));
@@ -55,6 +55,10 @@ typedef struct {
   BOOLEAN                 MediaPresent;
   BOOLEAN                 Initialized;
   SD_MMC_CARD_TYPE        CardType;
+  //
+  // The last command was CMD23 (SET_BLOCK_COUNT).
+  //
+  BOOLEAN                 BlockCountSet;
 } DW_MMC_HC_SLOT;
 
 typedef struct {
@@ -87,6 +91,13 @@ typedef struct {
   UINT64                           MaxCurrent[DW_MMC_HC_MAX_SLOT];
 
   UINT32                           ControllerVersion;
+
+  //
+  // IDMAC descriptor ring, mapped once and reused by every DMA transfer.
+  //
+  DW_MMC_HC_DMA_DESC_LINE          *DmaDesc;
+  EFI_PHYSICAL_ADDRESS             DmaDescPhy;
+  VOID                             *DmaDescMap;
 } DW_MMC_HC_PRIVATE_DATA;
 
 #define DW_MMC_HC_TRB_SIG  SIGNATURE_32 ('D', 'T', 'R', 'B')
@@ -113,13 +124,9 @@ typedef struct {
   BOOLEAN                                Started;
   UINT64                                 Timeout;
 
-  DW_MMC_HC_DMA_DESC_LINE                *DmaDesc;
-  EFI_PHYSICAL_ADDRESS                   DmaDescPhy;
-  UINT32                                 DmaDescPages;
-  VOID                                   *DmaMap;
-
   BOOLEAN                                UseFifo;
   BOOLEAN                                UseBE;               // Big-endian
+  BOOLEAN                                AutoStop;            // Auto CMD12
 
   DW_MMC_HC_PRIVATE_DATA                 *Private;
 } DW_MMC_HC_TRB;
@@ -660,6 +667,31 @@ DwMmcHcComponentNameGetControllerName (
   OUT CHAR16                          **ControllerName
   );
 
+/**
+  Allocate and map the IDMAC descriptor ring of the host controller.
+
+  @param[in] Private        A pointer to the DW_MMC_HC_PRIVATE_DATA instance.
+
+  @retval EFI_SUCCESS       The descriptor ring is ready for use.
+  @retval Others            The descriptor ring couldn't be allocated.
+
+**/
+EFI_STATUS
+DwMmcHcAllocDmaDescRing (
+  IN DW_MMC_HC_PRIVATE_DATA  *Private
+  );
+
+/**
+  Unmap and free the IDMAC descriptor ring of the host controller.
+
+  @param[in] Private        A pointer to the DW_MMC_HC_PRIVATE_DATA instance.
+
+**/
+VOID
+DwMmcHcFreeDmaDescRing (
+  IN DW_MMC_HC_PRIVATE_DATA  *Private
+  );
+
 /**
   Create a new TRB for the SD/MMC cmd request.
 
@@ -762,6 +794,19 @@ DwMmcCheckTrbResult (
   IN DW_MMC_HC_TRB           *Trb
   );
 
+/**
+  Stop the IDMAC once a TRB has completed, failed or timed out.
+
+  @param[in] Private        A pointer to the DW_MMC_HC_PRIVATE_DATA instance.
+  @param[in] Trb            The pointer to the DW_MMC_HC_TRB instance.
+
+**/
+VOID
+DwMmcStopTrbDma (
+  IN DW_MMC_HC_PRIVATE_DATA  *Private,
+  IN DW_MMC_HC_TRB           *Trb
+  );
+
 /**
   Wait for the TRB execution result.
 
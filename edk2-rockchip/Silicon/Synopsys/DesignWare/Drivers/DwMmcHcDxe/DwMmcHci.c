@@ -661,9 +661,127 @@ DwMmcHcStopDma (
   return EFI_SUCCESS;
 }
 
+/**
+  Stop the IDMAC once a TRB has completed, failed or timed out.
+
+  Only SD transfers are stopped, the eMMC path leaves the IDMAC running
+  between transfers.
+
+  @param[in] Private        A pointer to the DW_MMC_HC_PRIVATE_DATA instance.
+  @param[in] Trb            The pointer to the DW_MMC_HC_TRB instance.
+
+**/
+VOID
+DwMmcStopTrbDma (
+  IN DW_MMC_HC_PRIVATE_DATA  *Private,
+  IN DW_MMC_HC_TRB           *Trb
+  )
+{
+  if ((Trb->UseFifo == TRUE) || (Trb->DataLen == 0) ||
+      (Private->Slot[Trb->Slot].CardType != SdCardType))
+  {
+    return;
+  }
+
+  DwMmcHcStopDma (Private, Trb);
+}
+
+/**
+  Allocate and map the IDMAC descriptor ring of the host controller.
+
+  The ring is mapped as a common buffer once, so that transfers only need
+  to fill in the descriptors.
+
+  @param[in] Private        A pointer to the DW_MMC_HC_PRIVATE_DATA instance.
+
+  @retval EFI_SUCCESS       The descriptor ring is ready for use.
+  @retval Others            The descriptor ring couldn't be allocated.
+
+**/
+EFI_STATUS
+DwMmcHcAllocDmaDescRing (
+  IN DW_MMC_HC_PRIVATE_DATA  *Private
+  )
+{
+  EFI_STATUS  Status;
+  UINTN       Bytes;
+
+  Status = DmaAllocateBuffer (
+             EfiBootServicesData,
+             EFI_SIZE_TO_PAGES (DWMMC_DMA_DESC_RING_SIZE),
+             (VOID **)&Private->DmaDesc
+             );
+  if (EFI_ERROR (Status)) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  ZeroMem (Private->DmaDesc, DWMMC_DMA_DESC_RING_SIZE);
+  Bytes = DWMMC_DMA_DESC_RING_SIZE;
+
+  Status = DmaMap (
+             MapOperationBusMasterCommonBuffer,
+             Private->DmaDesc,
+             &Bytes,
+             &Private->DmaDescPhy,
+             &Private->DmaDescMap
+             );
+  if (EFI_ERROR (Status) || (Bytes != DWMMC_DMA_DESC_RING_SIZE)) {
+    //
+    // Map error or unable to map the whole ring into a contiguous region.
+    //
+    if (!EFI_ERROR (Status)) {
+      DmaUnmap (Private->DmaDescMap);
+    }
+
+    Status = EFI_OUT_OF_RESOURCES;
+    goto Error;
+  }
+
+  if ((Private->DmaDescPhy + DWMMC_DMA_DESC_RING_SIZE) > 0x100000000ul) {
+    //
+    // The DMA doesn't support 64bit addressing.
+    //
+    DmaUnmap (Private->DmaDescMap);
+    Status = EFI_DEVICE_ERROR;
+    goto Error;
+  }
+
+  return EFI_SUCCESS;
+
+Error:
+  DmaFreeBuffer (EFI_SIZE_TO_PAGES (DWMMC_DMA_DESC_RING_SIZE), Private->DmaDesc);
+  Private->DmaDesc    = NULL;
+  Private->DmaDescMap = NULL;
+  return Status;
+}
+
+/**
+  Unmap and free the IDMAC descriptor ring of the host controller.
+
+  @param[in] Private        A pointer to the DW_MMC_HC_PRIVATE_DATA instance.
+
+**/
+VOID
+DwMmcHcFreeDmaDescRing (
+  IN DW_MMC_HC_PRIVATE_DATA  *Private
+  )
+{
+  if (Private->DmaDesc == NULL) {
+    return;
+  }
+
+  DmaUnmap (Private->DmaDescMap);
+  DmaFreeBuffer (EFI_SIZE_TO_PAGES (DWMMC_DMA_DESC_RING_SIZE), Private->DmaDesc);
+  Private->DmaDesc    = NULL;
+  Private->DmaDescMap = NULL;
+}
+
 /**
   Build DMA descriptor table for transfer.
 
+  The descriptors are chained in the ring of the host controller, each one
+  covering up to DWMMC_DMA_BUF_SIZE bytes.
+
   @param[in] Trb            The pointer to the DW_MMC_HC_TRB instance.
 
   @retval EFI_SUCCESS       The DMA descriptor table is created successfully.
@@ -675,25 +793,24 @@ BuildDmaDescTable (
   IN DW_MMC_HC_TRB  *Trb
   )
 {
+  DW_MMC_HC_PRIVATE_DATA   *Private;
   EFI_PHYSICAL_ADDRESS     Data;
   UINT64                   DataLen;
   UINT64                   Entries;
   UINT32                   Index;
   UINT64                   Remaining;
-  UINTN                    TableSize;
   UINTN                    DevBase;
-  EFI_STATUS               Status;
-  UINTN                    Bytes;
   UINTN                    Blocks;
   DW_MMC_HC_DMA_DESC_LINE  *DmaDesc;
-  UINT32                   DmaDescPhy;
+  UINT32                   Length;
   UINT32                   Idsts;
   UINT32                   BytCnt;
   UINT32                   BlkSize;
 
+  Private = Trb->Private;
   Data    = Trb->DataPhy;
   DataLen = Trb->DataLen;
-  DevBase = Trb->Private->DevBase;
+  DevBase = Private->DevBase;
   //
   // Only support 32bit DMA Descriptor Table
   //
@@ -701,6 +818,10 @@ BuildDmaDescTable (
     return EFI_INVALID_PARAMETER;
   }
 
+  if (Private->DmaDesc == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
   //
   // Address field shall be set on 32-bit boundary (Lower 2-bit is always set
   // to 0) for 32-bit address descriptor table.
@@ -713,127 +834,66 @@ BuildDmaDescTable (
       ));
   }
 
-  Entries   = (DataLen + DWMMC_DMA_BUF_SIZE - 1) / DWMMC_DMA_BUF_SIZE;
-  TableSize = Entries * sizeof (DW_MMC_HC_DMA_DESC_LINE);
-  Blocks    = (DataLen + DW_MMC_BLOCK_SIZE - 1) / DW_MMC_BLOCK_SIZE;
-
-  Trb->DmaDescPages = (UINT32)EFI_SIZE_TO_PAGES (Entries * DWMMC_DMA_BUF_SIZE);
-
-  /*  Status = DevIo->AllocateBuffer (
-                      DevIo,
-                      AllocateAnyPages,
-                      EfiBootServicesData,
-                      EFI_SIZE_TO_PAGES (TableSize),
-                      (EFI_PHYSICAL_ADDRESS *)&Trb->DmaDesc
-                      );*/
-  Status = DmaAllocateBuffer (
-             EfiBootServicesData,
-             EFI_SIZE_TO_PAGES (TableSize),
-             (VOID *)&Trb->DmaDesc
-             );
-  if (EFI_ERROR (Status)) {
-    return EFI_OUT_OF_RESOURCES;
-  }
-
-  ZeroMem (Trb->DmaDesc, TableSize);
-  Bytes = TableSize;
-
-  Status = DmaMap (
-             MapOperationBusMasterCommonBuffer,
-             (EFI_PHYSICAL_ADDRESS *)Trb->DmaDesc,
-             &Bytes,
-             &Trb->DmaDescPhy,
-             &Trb->DmaMap
-             );
-
-  /*  Status = DevIo->Map (
-                      DevIo,
-                      EfiBusMasterCommonBuffer,
-                      (EFI_PHYSICAL_ADDRESS *)Trb->DmaDesc,
-                      &Bytes,
-                      &Trb->DmaDescPhy,
-                      &Trb->DmaMap
-                      );*/
-
-  if (EFI_ERROR (Status) || (Bytes != TableSize)) {
-    //
-    // Map error or unable to map the whole RFis buffer into a contiguous
-    // region.
-    //
-
-    /*    DevIo->FreeBuffer (
-                 DevIo,
-                 EFI_SIZE_TO_PAGES (TableSize),
-                 (EFI_PHYSICAL_ADDRESS)Trb->DmaDesc
-                 );*/
-    return EFI_OUT_OF_RESOURCES;
-  }
-
-  if ((UINT64)(UINTN)Trb->DmaDescPhy > 0x100000000ul) {
-    //
-    // The DMA doesn't support 64bit addressing.
-    //
-    DmaUnmap (Trb->DmaMap);
-
-    /*    DevIo->Unmap (
-          DevIo,
-          Trb->DmaMap
-        );*/
-    return EFI_DEVICE_ERROR;
-  }
+  Blocks = (DataLen + DW_MMC_BLOCK_SIZE - 1) / DW_MMC_BLOCK_SIZE;
 
   if (DataLen < DW_MMC_BLOCK_SIZE) {
-    BlkSize   = DataLen;
-    BytCnt    = DataLen;
-    Remaining = DataLen;
+    BlkSize = DataLen;
+    BytCnt  = DataLen;
   } else {
-    BlkSize   = DW_MMC_BLOCK_SIZE;
-    BytCnt    = DW_MMC_BLOCK_SIZE * Blocks;
-    Remaining = DW_MMC_BLOCK_SIZE * Blocks;
+    BlkSize = DW_MMC_BLOCK_SIZE;
+    BytCnt  = DW_MMC_BLOCK_SIZE * Blocks;
+  }
+
+  Entries = (BytCnt + DWMMC_DMA_BUF_SIZE - 1) / DWMMC_DMA_BUF_SIZE;
+  if (Entries > DWMMC_DMA_DESC_COUNT) {
+    DEBUG ((
+      DEBUG_ERROR,
+      "%a: Transfer of %u bytes exceeds the descriptor ring\n",
+      __func__,
+      BytCnt
+      ));
+    return EFI_BAD_BUFFER_SIZE;
   }
 
   MmioWrite32 (DevBase + DW_MMC_BLKSIZ, BlkSize);
   MmioWrite32 (DevBase + DW_MMC_BYTCNT, BytCnt);
-  DmaDesc = Trb->DmaDesc;
+
+  Remaining = BytCnt;
+  DmaDesc   = Private->DmaDesc;
   for (Index = 0; Index < Entries; Index++, DmaDesc++) {
+    Length = (UINT32)MIN (Remaining, DWMMC_DMA_BUF_SIZE);
+
     DmaDesc->Des0 = DW_MMC_IDMAC_DES0_OWN | DW_MMC_IDMAC_DES0_CH |
                     DW_MMC_IDMAC_DES0_DIC;
-    DmaDesc->Des1 = DW_MMC_IDMAC_DES1_BS1 (DWMMC_DMA_BUF_SIZE);
+    DmaDesc->Des1 = DW_MMC_IDMAC_DES1_BS1 (Length);
     //
     // Buffer Address
     //
-    DmaDesc->Des2 = (UINT32)((UINTN)Trb->DataPhy +
-                             (DWMMC_DMA_BUF_SIZE * Index));
+    DmaDesc->Des2 = (UINT32)(Data + (DWMMC_DMA_BUF_SIZE * Index));
     //
     // Next Descriptor Address
     //
-    DmaDesc->Des3 = (UINT32)((UINTN)Trb->DmaDescPhy +
+    DmaDesc->Des3 = (UINT32)(Private->DmaDescPhy +
                              sizeof (DW_MMC_HC_DMA_DESC_LINE) * (Index + 1));
-    Remaining = Remaining - DWMMC_DMA_BUF_SIZE;
+    Remaining -= Length;
   }
 
   //
   // First Descriptor
   //
-  Trb->DmaDesc[0].Des0 |= DW_MMC_IDMAC_DES0_FS;
+  Private->DmaDesc[0].Des0 |= DW_MMC_IDMAC_DES0_FS;
   //
   // Last Descriptor
   //
-  Trb->DmaDesc[Entries - 1].Des0 &= ~(DW_MMC_IDMAC_DES0_CH |
-                                      DW_MMC_IDMAC_DES0_DIC);
-  Trb->DmaDesc[Entries - 1].Des0 |= DW_MMC_IDMAC_DES0_OWN |
-                                    DW_MMC_IDMAC_DES0_LD;
-  Trb->DmaDesc[Entries - 1].Des1 = DW_MMC_IDMAC_DES1_BS1 (
-                                     Remaining +
-                                     DWMMC_DMA_BUF_SIZE
-                                     );
+  Private->DmaDesc[Entries - 1].Des0 &= ~(DW_MMC_IDMAC_DES0_CH |
+                                          DW_MMC_IDMAC_DES0_DIC);
+  Private->DmaDesc[Entries - 1].Des0 |= DW_MMC_IDMAC_DES0_LD;
   //
   // Set the next field of the Last Descriptor
   //
-  Trb->DmaDesc[Entries - 1].Des3 = 0;
-  DmaDescPhy                     = (UINT32)Trb->DmaDescPhy;
+  Private->DmaDesc[Entries - 1].Des3 = 0;
 
-  MmioWrite32 (DevBase + DW_MMC_DBADDR, DmaDescPhy);
+  MmioWrite32 (DevBase + DW_MMC_DBADDR, (UINT32)Private->DmaDescPhy);
 
   ArmDataSynchronizationBarrier ();
   ArmInstructionSynchronizationBarrier ();
@@ -843,7 +903,7 @@ BuildDmaDescTable (
   Idsts = ~0;
   MmioWrite32 (DevBase + DW_MMC_IDSTS, Idsts);
 
-  return Status;
+  return EFI_SUCCESS;
 }
 
 EFI_STATUS
@@ -968,6 +1028,27 @@ Verify:
   return EFI_SUCCESS;
 }
 
+/**
+  Check whether the command is an open-ended multi-block transfer.
+
+  SD and eMMC use the same command indexes for these.
+
+  @param[in] CommandIndex   The index of the command.
+
+  @retval TRUE              The command is CMD18 or CMD25.
+  @retval FALSE             The command is anything else.
+
+**/
+STATIC
+BOOLEAN
+DwMmcIsMultiBlockCmd (
+  IN UINT16  CommandIndex
+  )
+{
+  return (CommandIndex == EMMC_READ_MULTIPLE_BLOCK) ||
+         (CommandIndex == EMMC_WRITE_MULTIPLE_BLOCK);
+}
+
 /**
   Create a new TRB for the SD/MMC cmd request.
 
@@ -996,6 +1077,8 @@ DwMmcCreateTrb (
   EFI_TPL                OldTpl;
   EFI_IO_OPERATION_TYPE  Flag;
   UINTN                  MapLength;
+  DW_MMC_HC_SLOT         *SlotData;
+  UINT16                 CommandIndex;
 
   Trb = AllocateZeroPool (sizeof (DW_MMC_HC_TRB));
   if (Trb == NULL) {
@@ -1011,11 +1094,20 @@ DwMmcCreateTrb (
   Trb->Timeout   = Packet->Timeout;
   Trb->Private   = Private;
 
+  SlotData     = &Private->Slot[Slot];
+  CommandIndex = Packet->SdMmcCmdBlk->CommandIndex;
+
+  //
+  // Multi-block transfers are stopped by the controller sending CMD12 on its
+  // own, unless CMD23 has set the block count beforehand.
+  //
+  Trb->AutoStop           = DwMmcIsMultiBlockCmd (CommandIndex) && !SlotData->BlockCountSet;
+  SlotData->BlockCountSet = (CommandIndex == EMMC_SET_BLOCK_COUNT);
+
   if ((Packet->InTransferLength != 0) && (Packet->InDataBuffer != NULL)) {
     Trb->Data    = Packet->InDataBuffer;
     Trb->DataLen = Packet->InTransferLength;
     Trb->Read    = TRUE;
-    ZeroMem (Trb->Data, Trb->DataLen);
   } else if (Packet->OutTransferLength && (Packet->OutDataBuffer != NULL)) {
     Trb->Data    = Packet->OutDataBuffer;
     Trb->DataLen = Packet->OutTransferLength;
@@ -1040,8 +1132,17 @@ DwMmcCreateTrb (
       Flag = EfiBusMasterRead;
     }
 
-    if (Private->Slot[Trb->Slot].CardType == SdCardType) {
+    //
+    // SD cards use PIO for everything but multi-block transfers, which
+    // go through the IDMAC.
+    //
+    if ((SlotData->CardType == SdCardType) &&
+        !DwMmcIsMultiBlockCmd (CommandIndex))
+    {
       Trb->UseFifo = TRUE;
+      if (Trb->Read && Trb->DataLen) {
+        ZeroMem (Trb->Data, Trb->DataLen);
+      }
     } else {
       Trb->UseFifo = FALSE;
       if (Trb->DataLen) {
@@ -1099,10 +1200,6 @@ DwMmcFreeTrb (
   IN DW_MMC_HC_TRB  *Trb
   )
 {
-  if (Trb->DmaMap != NULL) {
-    DmaUnmap (Trb->DmaMap);
-  }
-
   if (Trb->DataMap != NULL) {
     DmaUnmap (Trb->DataMap);
   }
@@ -1237,6 +1334,10 @@ DwEmmcExecTrb (
              BIT_CMD_WRITE;
     }
 
+    if (Trb->AutoStop) {
+      Cmd |= BIT_CMD_SEND_AUTO_STOP;
+    }
+
     Cmd |= BIT_CMD_RESPONSE_EXPECT | BIT_CMD_CHECK_RESPONSE_CRC;
   } else {
     switch (Packet->SdMmcCmdBlk->CommandIndex) {
@@ -1353,7 +1454,6 @@ DwSdExecTrb (
   UINT32                               Argument;
   UINT32                               ErrMask;
   UINT32                               Timeout;
-  UINT32                               Idsts;
   UINT32                               BytCnt;
   UINT32                               BlkSize;
   EFI_STATUS                           Status;
@@ -1396,8 +1496,11 @@ DwSdExecTrb (
              BIT_CMD_WRITE;
     }
 
-    Cmd |= BIT_CMD_RESPONSE_EXPECT | BIT_CMD_CHECK_RESPONSE_CRC |
-           BIT_CMD_SEND_AUTO_STOP;
+    if (Trb->AutoStop) {
+      Cmd |= BIT_CMD_SEND_AUTO_STOP;
+    }
+
+    Cmd |= BIT_CMD_RESPONSE_EXPECT | BIT_CMD_CHECK_RESPONSE_CRC;
   } else {
     switch (Packet->SdMmcCmdBlk->CommandIndex) {
       case SD_GO_IDLE_STATE:
@@ -1492,34 +1595,16 @@ DwSdExecTrb (
     return EFI_DEVICE_ERROR;
   }
 
-  if (Trb->DataLen) {
-    if (Trb->UseFifo == TRUE) {
-      Status = TransferFifo (Trb);
-      if (EFI_ERROR (Status)) {
-        return Status;
-      }
-    } else {
-      if (Packet->InTransferLength) {
-        do {
-          Idsts = MmioRead32 (DevBase + DW_MMC_IDSTS);
-        } while ((Idsts & DW_MMC_IDSTS_RI) == 0);
-
-        Status = DwMmcHcStopDma (Private, Trb);
-        if (EFI_ERROR (Status)) {
-          return Status;
-        }
-      } else if (Packet->OutTransferLength) {
-        do {
-          Idsts = MmioRead32 (DevBase + DW_MMC_IDSTS);
-        } while ((Idsts & DW_MMC_IDSTS_TI) == 0);
-
-        Status = DwMmcHcStopDma (Private, Trb);
-        if (EFI_ERROR (Status)) {
-          return Status;
-        }
-      } /* Packet->InTransferLength */
-    } /* UseFifo */
-  } /* Trb->DataLen */
+  //
+  // IDMAC transfers complete in DwMmcCheckTrbResult(), which is polled
+  // with the packet timeout.
+  //
+  if (Trb->DataLen && (Trb->UseFifo == TRUE)) {
+    Status = TransferFifo (Trb);
+    if (EFI_ERROR (Status)) {
+      return Status;
+    }
+  }
 
   switch (Packet->SdMmcCmdBlk->ResponseType) {
     case SdMmcResponseTypeR1:
@@ -1617,6 +1702,8 @@ DwMmcCheckTrbResult (
   UINT32                               Idsts;
   UINTN                                DevBase;
   UINT32                               IntStatus;
+  UINT32                               ErrMask;
+  EFI_STATUS                           Status;
 
   DevBase = Private->DevBase;
   Packet  = Trb->Packet;
@@ -1626,7 +1713,7 @@ DwMmcCheckTrbResult (
       //
       // Check Auto CMD12 completion
       //
-      if (!(IntStatus & DW_MMC_INT_ACD)) {
+      if (Trb->AutoStop && !(IntStatus & DW_MMC_INT_ACD)) {
         return EFI_NOT_READY;
       }
 
@@ -1656,22 +1743,47 @@ DwMmcCheckTrbResult (
     return EFI_SUCCESS;
   }
 
-  if (Packet->InTransferLength) {
-    do {
-      Idsts = MmioRead32 (DevBase + DW_MMC_IDSTS);
-    } while ((Idsts & BIT1) == 0);
-  } else if (Packet->OutTransferLength) {
-    do {
-      Idsts = MmioRead32 (DevBase + DW_MMC_IDSTS);
-    } while ((Idsts & BIT0) == 0);
-  } else {
+  if (!Packet->InTransferLength && !Packet->OutTransferLength) {
     return EFI_SUCCESS;
   }
 
+  IntStatus = MmioRead32 (DevBase + DW_MMC_RINTSTS);
+  Idsts     = MmioRead32 (DevBase + DW_MMC_IDSTS);
+
+  ErrMask = DW_MMC_INT_EBE | DW_MMC_INT_SBE | DW_MMC_INT_HTO |
+            DW_MMC_INT_DRT | DW_MMC_INT_DCRC;
+  if ((IntStatus & ErrMask) || (Idsts & DW_MMC_IDSTS_ERR)) {
+    DEBUG ((
+      DEBUG_ERROR,
+      "%a: Data error. CmdIndex=%d, IntStatus=0x%x, Idsts=0x%x\n",
+      __func__,
+      Packet->SdMmcCmdBlk->CommandIndex,
+      IntStatus,
+      Idsts
+      ));
+    Status = EFI_DEVICE_ERROR;
+  } else {
+    if (Trb->AutoStop && !(IntStatus & DW_MMC_INT_ACD)) {
+      return EFI_NOT_READY;
+    }
+
+    if (Packet->InTransferLength && !(Idsts & DW_MMC_IDSTS_RI)) {
+      return EFI_NOT_READY;
+    }
+
+    if (Packet->OutTransferLength && !(Idsts & DW_MMC_IDSTS_TI)) {
+      return EFI_NOT_READY;
+    }
+
+    Status = EFI_SUCCESS;
+  }
+
+  DwMmcStopTrbDma (Private, Trb);
+
   Idsts = ~0;
   MmioWrite32 (DevBase + DW_MMC_IDSTS, Idsts);
 
-  return EFI_SUCCESS;
+  return Status;
 }
 
 /**
@@ -1724,5 +1836,7 @@ DwMmcWaitTrbResult (
     Timeout--;
   }
 
+  DwMmcStopTrbDma (Private, Trb);
+
   return EFI_TIMEOUT;
 }
@@ -165,8 +165,15 @@
 #define DW_MMC_BMOD_FB   (1 << 1)                                /* Fix Burst */
 #define DW_MMC_BMOD_DE   (1 << 7)                                /* IDMAC Enable */
 
-#define DW_MMC_IDSTS_TI  (1 << 0)                                /* Transmit Interrupt */
-#define DW_MMC_IDSTS_RI  (1 << 1)                                /* Receive Interrupt */
+#define DW_MMC_IDSTS_TI   (1 << 0)                               /* Transmit Interrupt */
+#define DW_MMC_IDSTS_RI   (1 << 1)                               /* Receive Interrupt */
+#define DW_MMC_IDSTS_FBE  (1 << 2)                               /* Fatal Bus Error */
+#define DW_MMC_IDSTS_DU   (1 << 4)                               /* Descriptor Unavailable */
+#define DW_MMC_IDSTS_CES  (1 << 5)                               /* Card Error Summary */
+#define DW_MMC_IDSTS_AIS  (1 << 9)                               /* Abnormal Interrupt Summary */
+
+#define DW_MMC_IDSTS_ERR  (DW_MMC_IDSTS_FBE | DW_MMC_IDSTS_DU |   \
+                           DW_MMC_IDSTS_CES | DW_MMC_IDSTS_AIS)
 
 #define DW_MMC_FIFO_TWMARK(x)     ((x) & 0xfff)
 #define DW_MMC_FIFO_RWMARK(x)     (((x) & 0x1ff) << 16)
@@ -187,9 +194,21 @@
 #define UHSEXT_SAMPLE_DRVPHASE(x)  (((x) & 0x1f) << 21)
 #define UHSEXT_SAMPLE_DLY(x)       (((x) & 0x1f) << 26)
 
-#define DWMMC_DMA_BUF_SIZE    (512 * 8)
+//
+// Largest buffer a single chained IDMAC descriptor can address (13-bit BS1
+// field), rounded down to whole blocks.
+//
+#define DWMMC_DMA_BUF_SIZE    (DW_MMC_BLOCK_SIZE * 15)
 #define DWMMC_FIFO_THRESHOLD  16
 
+//
+// Number of descriptors in the per-controller IDMAC descriptor ring.
+// 8192 descriptors cover a 60 MB transfer, more than the 65535 blocks
+// a single SD/eMMC multi-block command is split into.
+//
+#define DWMMC_DMA_DESC_COUNT      8192
+#define DWMMC_DMA_DESC_RING_SIZE  (DWMMC_DMA_DESC_COUNT * sizeof (DW_MMC_HC_DMA_DESC_LINE))
+
 #define DWMMC_INIT_CLOCK_FREQ  400                               /* KHz */
 
 //
@@ -13,6 +13,7 @@
 
 #include <Library/BaseLib.h>
 #include <Library/BaseMemoryLib.h>
+#include <Library/CacheMaintenanceLib.h>
 #include <Library/DebugLib.h>
 #include <Library/DmaLib.h>
 #include <Library/MemoryAllocationLib.h>
@@ -29,11 +30,21 @@
 #include "EqosHw.h"
 
 //
-// XXX: Having more RX descriptors (e.g. 256) affects performance
-// and seems to lead to more TCP segments getting dropped.
+// The RX ring needs to be deep enough to absorb a burst of TCP segments
+// while the network stack is not polling us. RX buffers stay mapped for
+// the lifetime of the ring and consumed descriptors are handed back to
+// the DMA in batches of EQOS_RX_REFILL_BATCH, so that a deep ring does
+// not cost a DmaMap() and a tail pointer write per received frame.
+//
+// EQOS_RX_DESC_COUNT may be overridden from the platform build options.
 //
 #define EQOS_TX_DESC_COUNT  32
-#define EQOS_RX_DESC_COUNT  2
+
+#ifndef EQOS_RX_DESC_COUNT
+#define EQOS_RX_DESC_COUNT  128
+#endif
+
+#define EQOS_RX_REFILL_BATCH  MIN (16, EQOS_RX_DESC_COUNT / 4)
 
 #define EQOS_DESC_ALIGN  sizeof (struct EQOS_DMA_DESCRIPTOR)
 
@@ -84,8 +95,15 @@ typedef struct {
   VOID                                 *RxDescsMap;
   EFI_PHYSICAL_ADDRESS                 RxDescsPhysAddr;
   EFI_PHYSICAL_ADDRESS                 RxBuffersAddr;
-  VOID                                 *RxBuffersMap[EQOS_RX_DESC_COUNT];
+  EFI_PHYSICAL_ADDRESS                 RxBuffersPhysAddr;
+  VOID                                 *RxBuffersMap;
   UINT32                               RxCurrent;
+  UINT32                               RxRefillPending;
+  UINT32                               RxRefillLast;
+
+  EFI_NETWORK_STATISTICS               Stats;
+  UINT64                               TxRingFull;
+  UINT64                               RxDescErrors;
 
   UINT32                               HwFeatures[4];
 
@@ -103,8 +121,9 @@ extern CONST EFI_ADAPTER_INFORMATION_PROTOCOL  gEqosAipTemplate;
 #define EQOS_PRIVATE_DATA_FROM_SNP_THIS(a)  CR (a, EQOS_PRIVATE_DATA, Snp, EQOS_DRIVER_SIGNATURE)
 #define EQOS_PRIVATE_DATA_FROM_AIP_THIS(a)  CR (a, EQOS_PRIVATE_DATA, Aip, EQOS_DRIVER_SIGNATURE)
 
-#define EQOS_RX_BUFFER(p, idx)  ((UINT8 *)(UINTN)(p)->RxBuffersAddr + EQOS_RX_BUFFER_SIZE * (idx))
-#define EQOS_DESC(buf, idx)     ((EQOS_DMA_DESCRIPTOR *)((UINTN)(buf) + EQOS_DESC_OFF ((idx))))
+#define EQOS_RX_BUFFER(p, idx)       ((UINT8 *)(UINTN)(p)->RxBuffersAddr + EQOS_RX_BUFFER_SIZE * (idx))
+#define EQOS_RX_BUFFER_PHYS(p, idx)  ((p)->RxBuffersPhysAddr + EQOS_RX_BUFFER_SIZE * (idx))
+#define EQOS_DESC(buf, idx)          ((EQOS_DMA_DESCRIPTOR *)((UINTN)(buf) + EQOS_DESC_OFF ((idx))))
 
 EFI_STATUS
 EqosIdentify (
@@ -168,22 +187,21 @@ EqosDmaMapTxDescriptor (
   IN UINTN              NumberOfBytes
   );
 
-EFI_STATUS
-EqosDmaMapRxDescriptor (
+VOID
+EqosDmaRefillRxDescriptor (
   IN EQOS_PRIVATE_DATA  *Eqos,
   IN UINT32             DescIndex
   );
 
 VOID
-EqosDmaUnmapTxDescriptor (
-  IN  EQOS_PRIVATE_DATA  *Eqos,
-  IN UINT32              DescIndex
+EqosDmaFlushRxDescriptors (
+  IN EQOS_PRIVATE_DATA  *Eqos
   );
 
 VOID
-EqosDmaUnmapRxDescriptor (
-  IN EQOS_PRIVATE_DATA  *Eqos,
-  IN UINT32             DescIndex
+EqosDmaUnmapTxDescriptor (
+  IN  EQOS_PRIVATE_DATA  *Eqos,
+  IN UINT32              DescIndex
   );
 
 EFI_STATUS
@@ -240,6 +258,16 @@ EqosUpdateLink (
   IN EQOS_PRIVATE_DATA  *Eqos
   );
 
+VOID
+EqosUpdateStatistics (
+  IN EQOS_PRIVATE_DATA  *Eqos
+  );
+
+VOID
+EqosResetStatistics (
+  IN EQOS_PRIVATE_DATA  *Eqos
+  );
+
 EFI_STATUS
 EqosSetRxFilters (
   IN EQOS_PRIVATE_DATA  *Eqos,
@@ -138,6 +138,10 @@
 #define GMAC_TX_OCTET_COUNT_GOOD_BAD                0x0714
 #define GMAC_TX_PACKET_COUNT_GOOD_BAD               0x0718
 #define GMAC_TX_UNDERFLOW_ERROR_PACKETS             0x0748
+#define GMAC_TX_SINGLE_COLLISION_GOOD_PACKETS       0x074C
+#define GMAC_TX_MULTIPLE_COLLISION_GOOD_PACKETS     0x0750
+#define GMAC_TX_LATE_COLLISION_PACKETS              0x0758
+#define GMAC_TX_EXCESSIVE_COLLISION_PACKETS         0x075C
 #define GMAC_TX_CARRIER_ERROR_PACKETS               0x0760
 #define GMAC_TX_OCTET_COUNT_GOOD                    0x0764
 #define GMAC_TX_PACKET_COUNT_GOOD                   0x0768
@@ -146,6 +150,10 @@
 #define GMAC_RX_OCTET_COUNT_GOOD                    0x0788
 #define GMAC_RX_MULTICAST_PACKETS_GOOD              0x0790
 #define GMAC_RX_CRC_ERROR_PACKETS                   0x0794
+#define GMAC_RX_RUNT_ERROR_PACKETS                  0x079C
+#define GMAC_RX_JABBER_ERROR_PACKETS                0x07A0
+#define GMAC_RX_UNDERSIZE_PACKETS_GOOD              0x07A4
+#define GMAC_RX_OVERSIZE_PACKETS_GOOD               0x07A8
 #define GMAC_RX_LENGTH_ERROR_PACKETS                0x07C8
 #define GMAC_RX_FIFO_OVERFLOW_PACKETS               0x07D4
 #define GMAC_MMC_IPC_RX_INTERRUPT_MASK              0x0800
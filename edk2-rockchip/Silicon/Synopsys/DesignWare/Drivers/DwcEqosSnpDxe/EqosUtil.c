@@ -177,14 +177,19 @@ EqosInitialize (
   MmioWrite32 (Eqos->Base + GMAC_DMA_CHAN0_RX_CONTROL, Value);
 
   //
-  // Disable counters
+  // Reset the counters and have them clear on read, they get
+  // accumulated into Eqos->Stats by EqosUpdateStatistics().
+  // The counter interrupts are of no use to us.
   //
+  MmioWrite32 (Eqos->Base + GMAC_MMC_RX_INTERRUPT_MASK, MAX_UINT32);
+  MmioWrite32 (Eqos->Base + GMAC_MMC_TX_INTERRUPT_MASK, MAX_UINT32);
+  MmioWrite32 (Eqos->Base + GMAC_MMC_IPC_RX_INTERRUPT_MASK, MAX_UINT32);
   MmioWrite32 (
     Eqos->Base + GMAC_MMC_CONTROL,
-    GMAC_MMC_CONTROL_CNTFREEZ |
-    GMAC_MMC_CONTROL_CNTPRST |
-    GMAC_MMC_CONTROL_CNTPRSTLVL
+    GMAC_MMC_CONTROL_CNTRST |
+    GMAC_MMC_CONTROL_RSTONRD
     );
+  EqosResetStatistics (Eqos);
 
   //
   // Configure operation modes
@@ -585,35 +590,19 @@ EqosDmaMapTxDescriptor (
   return EFI_SUCCESS;
 }
 
-EFI_STATUS
-EqosDmaMapRxDescriptor (
+VOID
+EqosDmaRefillRxDescriptor (
   IN EQOS_PRIVATE_DATA  *Eqos,
   IN UINT32             DescIndex
   )
 {
-  EFI_STATUS            Status;
-  UINTN                 NumberOfBytes;
   EFI_PHYSICAL_ADDRESS  BufferPhysAddr;
   EQOS_DMA_DESCRIPTOR   *Descriptor;
 
-  ASSERT (Eqos->RxBuffersMap[DescIndex] == NULL);
-  ASSERT (Eqos->RxBuffersAddr != 0);
-
-  NumberOfBytes = EQOS_RX_BUFFER_SIZE;
-
-  Status = DmaMap (
-             MapOperationBusMasterWrite,
-             EQOS_RX_BUFFER (Eqos, DescIndex),
-             &NumberOfBytes,
-             &BufferPhysAddr,
-             &Eqos->RxBuffersMap[DescIndex]
-             );
-  if (EFI_ERROR (Status)) {
-    DEBUG ((DEBUG_ERROR, "%a: Failed to map RX buffer. Status=%r\n", __func__, Status));
-    return Status;
-  }
+  ASSERT (Eqos->RxBuffersMap != NULL);
 
-  Descriptor = EQOS_DESC (Eqos->RxDescs, DescIndex);
+  BufferPhysAddr = EQOS_RX_BUFFER_PHYS (Eqos, DescIndex);
+  Descriptor     = EQOS_DESC (Eqos->RxDescs, DescIndex);
 
   Descriptor->Tdes0 = (UINT32)(BufferPhysAddr);
   Descriptor->Tdes1 = (UINT32)(BufferPhysAddr >> 32);
@@ -621,32 +610,45 @@ EqosDmaMapRxDescriptor (
   MemoryFence ();
   Descriptor->Tdes3 = EQOS_TDES3_RX_OWN | EQOS_TDES3_RX_IOC | EQOS_TDES3_RX_BUF1V;
 
-  MmioWrite32 (Eqos->Base + GMAC_DMA_CHAN0_RX_END_ADDR, (UINT32)(UINTN)Descriptor);
+  //
+  // The descriptor is owned by the DMA now, but it will only fetch it
+  // once the tail pointer moves past it. Do that in batches.
+  //
+  Eqos->RxRefillLast = DescIndex;
+  Eqos->RxRefillPending++;
 
-  return EFI_SUCCESS;
+  if (Eqos->RxRefillPending >= EQOS_RX_REFILL_BATCH) {
+    EqosDmaFlushRxDescriptors (Eqos);
+  }
 }
 
 VOID
-EqosDmaUnmapTxDescriptor (
-  IN  EQOS_PRIVATE_DATA  *Eqos,
-  IN UINT32              DescIndex
+EqosDmaFlushRxDescriptors (
+  IN EQOS_PRIVATE_DATA  *Eqos
   )
 {
-  if (Eqos->TxBuffersMap[DescIndex] != NULL) {
-    DmaUnmap (Eqos->TxBuffersMap[DescIndex]);
-    Eqos->TxBuffersMap[DescIndex] = NULL;
+  if (Eqos->RxRefillPending == 0) {
+    return;
   }
+
+  MemoryFence ();
+  MmioWrite32 (
+    Eqos->Base + GMAC_DMA_CHAN0_RX_END_ADDR,
+    (UINT32)(Eqos->RxDescsPhysAddr + EQOS_DESC_OFF (Eqos->RxRefillLast))
+    );
+
+  Eqos->RxRefillPending = 0;
 }
 
 VOID
-EqosDmaUnmapRxDescriptor (
-  IN EQOS_PRIVATE_DATA  *Eqos,
-  IN UINT32             DescIndex
+EqosDmaUnmapTxDescriptor (
+  IN  EQOS_PRIVATE_DATA  *Eqos,
+  IN UINT32              DescIndex
   )
 {
-  if (Eqos->RxBuffersMap[DescIndex] != NULL) {
-    DmaUnmap (Eqos->RxBuffersMap[DescIndex]);
-    Eqos->RxBuffersMap[DescIndex] = NULL;
+  if (Eqos->TxBuffersMap[DescIndex] != NULL) {
+    DmaUnmap (Eqos->TxBuffersMap[DescIndex]);
+    Eqos->TxBuffersMap[DescIndex] = NULL;
   }
 }
 
@@ -656,16 +658,40 @@ EqosDmaMapAllRxDescriptors (
   )
 {
   EFI_STATUS  Status;
+  UINTN       NumberOfBytes;
   UINT32      Index;
 
+  ASSERT (Eqos->RxBuffersMap == NULL);
+  ASSERT (Eqos->RxBuffersAddr != 0);
+
+  //
+  // Map the whole buffer pool once. The CPU never writes to it, so the
+  // only maintenance needed afterwards is invalidating each frame before
+  // it is read (see EqosSnpReceive).
+  //
+  NumberOfBytes = EQOS_RX_BUFFER_SIZE * EQOS_RX_DESC_COUNT;
+
+  Status = DmaMap (
+             MapOperationBusMasterWrite,
+             (VOID *)(UINTN)Eqos->RxBuffersAddr,
+             &NumberOfBytes,
+             &Eqos->RxBuffersPhysAddr,
+             &Eqos->RxBuffersMap
+             );
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "%a: Failed to map RX buffers. Status=%r\n", __func__, Status));
+    Eqos->RxBuffersMap = NULL;
+    return Status;
+  }
+
+  Eqos->RxRefillPending = 0;
+
   for (Index = 0; Index < EQOS_RX_DESC_COUNT; Index++) {
-    Status = EqosDmaMapRxDescriptor (Eqos, Index);
-    if (EFI_ERROR (Status)) {
-      EqosDmaUnmapAllRxDescriptors (Eqos);
-      return Status;
-    }
+    EqosDmaRefillRxDescriptor (Eqos, Index);
   }
 
+  EqosDmaFlushRxDescriptors (Eqos);
+
   return EFI_SUCCESS;
 }
 
@@ -686,11 +712,12 @@ EqosDmaUnmapAllRxDescriptors (
   IN EQOS_PRIVATE_DATA  *Eqos
   )
 {
-  UINT32  Index;
-
-  for (Index = 0; Index < EQOS_RX_DESC_COUNT; Index++) {
-    EqosDmaUnmapRxDescriptor (Eqos, Index);
+  if (Eqos->RxBuffersMap != NULL) {
+    DmaUnmap (Eqos->RxBuffersMap);
+    Eqos->RxBuffersMap = NULL;
   }
+
+  Eqos->RxRefillPending = 0;
 }
 
 EFI_STATUS
@@ -1035,6 +1062,77 @@ EqosUpdateLink (
   return LinkUp ? EFI_SUCCESS : EFI_NO_MEDIA;
 }
 
+VOID
+EqosUpdateStatistics (
+  IN EQOS_PRIVATE_DATA  *Eqos
+  )
+{
+  EFI_NETWORK_STATISTICS  *Stats;
+  EFI_PHYSICAL_ADDRESS    Base;
+
+  //
+  // Frame and byte totals are counted in software, as the 32-bit
+  // octet counters would wrap within seconds at gigabit speed.
+  // Only take the error counters from the MMC.
+  //
+  Stats = &Eqos->Stats;
+  Base  = Eqos->Base;
+
+  Stats->RxCrcErrorFrames  += MmioRead32 (Base + GMAC_RX_CRC_ERROR_PACKETS);
+  Stats->RxUndersizeFrames += MmioRead32 (Base + GMAC_RX_RUNT_ERROR_PACKETS);
+  Stats->RxUndersizeFrames += MmioRead32 (Base + GMAC_RX_UNDERSIZE_PACKETS_GOOD);
+  Stats->RxOversizeFrames  += MmioRead32 (Base + GMAC_RX_OVERSIZE_PACKETS_GOOD);
+  Stats->RxOversizeFrames  += MmioRead32 (Base + GMAC_RX_JABBER_ERROR_PACKETS);
+  Stats->RxDroppedFrames   += MmioRead32 (Base + GMAC_RX_FIFO_OVERFLOW_PACKETS);
+  Stats->RxDroppedFrames   += MmioRead32 (Base + GMAC_RX_LENGTH_ERROR_PACKETS);
+
+  Stats->Collisions += MmioRead32 (Base + GMAC_TX_SINGLE_COLLISION_GOOD_PACKETS);
+  Stats->Collisions += MmioRead32 (Base + GMAC_TX_MULTIPLE_COLLISION_GOOD_PACKETS);
+  Stats->Collisions += MmioRead32 (Base + GMAC_TX_LATE_COLLISION_PACKETS);
+  Stats->Collisions += MmioRead32 (Base + GMAC_TX_EXCESSIVE_COLLISION_PACKETS);
+}
+
+VOID
+EqosResetStatistics (
+  IN EQOS_PRIVATE_DATA  *Eqos
+  )
+{
+  EFI_NETWORK_STATISTICS  *Stats;
+  UINT32                  Value;
+
+  Value  = MmioRead32 (Eqos->Base + GMAC_MMC_CONTROL);
+  Value |= GMAC_MMC_CONTROL_CNTRST;
+  MmioWrite32 (Eqos->Base + GMAC_MMC_CONTROL, Value);
+
+  //
+  // Counters we don't keep must read as all-ones per the UEFI spec.
+  //
+  Stats = &Eqos->Stats;
+  SetMem (Stats, sizeof (*Stats), 0xFF);
+
+  Stats->RxTotalFrames     = 0;
+  Stats->RxGoodFrames      = 0;
+  Stats->RxUndersizeFrames = 0;
+  Stats->RxOversizeFrames  = 0;
+  Stats->RxDroppedFrames   = 0;
+  Stats->RxUnicastFrames   = 0;
+  Stats->RxBroadcastFrames = 0;
+  Stats->RxMulticastFrames = 0;
+  Stats->RxCrcErrorFrames  = 0;
+  Stats->RxTotalBytes      = 0;
+  Stats->TxTotalFrames     = 0;
+  Stats->TxGoodFrames      = 0;
+  Stats->TxUnicastFrames   = 0;
+  Stats->TxBroadcastFrames = 0;
+  Stats->TxMulticastFrames = 0;
+  Stats->TxTotalBytes      = 0;
+  Stats->TxErrorFrames     = 0;
+  Stats->Collisions        = 0;
+
+  Eqos->TxRingFull   = 0;
+  Eqos->RxDescErrors = 0;
+}
+
 EFI_STATUS
 EqosSetRxFilters (
   IN EQOS_PRIVATE_DATA  *Eqos,
@@ -8,6 +8,38 @@
 
 #include "Eqos.h"
 
+/**
+  Accounts a frame in the unicast, broadcast or multicast counter
+  matching its destination address.
+
+  @param  Frame     The frame, starting with the media header.
+  @param  Unicast   The unicast frames counter.
+  @param  Broadcast The broadcast frames counter.
+  @param  Multicast The multicast frames counter.
+
+**/
+STATIC
+VOID
+EqosCountFrameType (
+  IN     CONST UINT8  *Frame,
+  IN OUT UINT64       *Unicast,
+  IN OUT UINT64       *Broadcast,
+  IN OUT UINT64       *Multicast
+  )
+{
+  STATIC CONST UINT8  BroadcastAddr[NET_ETHER_ADDR_LEN] = {
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF
+  };
+
+  if (CompareMem (Frame, BroadcastAddr, NET_ETHER_ADDR_LEN) == 0) {
+    (*Broadcast)++;
+  } else if ((Frame[0] & 0x01) != 0) {
+    (*Multicast)++;
+  } else {
+    (*Unicast)++;
+  }
+}
+
 /**
   Changes the state of a network interface from "stopped" to "started".
 
@@ -428,7 +460,70 @@ EqosSnpStatistics (
   OUT EFI_NETWORK_STATISTICS       *StatisticsTable OPTIONAL
   )
 {
-  return EFI_UNSUPPORTED;
+  EQOS_PRIVATE_DATA  *Eqos;
+  EFI_STATUS         Status;
+
+  if (This == NULL) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  if ((StatisticsSize == NULL) && ((StatisticsTable != NULL) || !Reset)) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  Eqos = EQOS_PRIVATE_DATA_FROM_SNP_THIS (This);
+  if (Eqos->SnpMode.State == EfiSimpleNetworkStopped) {
+    return EFI_NOT_STARTED;
+  }
+
+  if (Eqos->SnpMode.State != EfiSimpleNetworkInitialized) {
+    return EFI_DEVICE_ERROR;
+  }
+
+  Status = EfiAcquireLockOrFail (&Eqos->Lock);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "%a: Failed to get lock. Status=%r\n", __func__, Status));
+    return EFI_ACCESS_DENIED;
+  }
+
+  EqosUpdateStatistics (Eqos);
+
+  DEBUG ((
+    DEBUG_INFO,
+    "%a: RX: %lu frames, %lu dropped, %lu descriptor errors. TX: %lu frames, %lu errors, ring full %lu times\n",
+    __func__,
+    Eqos->Stats.RxGoodFrames,
+    Eqos->Stats.RxDroppedFrames,
+    Eqos->RxDescErrors,
+    Eqos->Stats.TxGoodFrames,
+    Eqos->Stats.TxErrorFrames,
+    Eqos->TxRingFull
+    ));
+
+  Status = EFI_SUCCESS;
+
+  if (StatisticsSize != NULL) {
+    if (StatisticsTable != NULL) {
+      CopyMem (
+        StatisticsTable,
+        &Eqos->Stats,
+        MIN (*StatisticsSize, sizeof (EFI_NETWORK_STATISTICS))
+        );
+    }
+
+    if (*StatisticsSize < sizeof (EFI_NETWORK_STATISTICS)) {
+      Status = EFI_BUFFER_TOO_SMALL;
+    }
+
+    *StatisticsSize = sizeof (EFI_NETWORK_STATISTICS);
+  }
+
+  if (Reset) {
+    EqosResetStatistics (Eqos);
+  }
+
+  EfiReleaseLock (&Eqos->Lock);
+  return Status;
 }
 
 /**
@@ -611,6 +706,12 @@ EqosSnpGetStatus (
 
       Status = EqosCheckTxDescriptor (Eqos, DescIndex);
       if (Status != EFI_NOT_READY) {
+        if (EFI_ERROR (Status)) {
+          Eqos->Stats.TxErrorFrames++;
+        } else {
+          Eqos->Stats.TxGoodFrames++;
+        }
+
         ASSERT (Eqos->TxBuffersMap[DescIndex] != NULL);
         EqosDmaUnmapTxDescriptor (Eqos, DescIndex);
 
@@ -725,6 +826,7 @@ EqosSnpTransmit (
   }
 
   if (Eqos->TxQueued == EQOS_TX_DESC_COUNT - 1) {
+    Eqos->TxRingFull++;
     Status = EFI_NOT_READY;
     goto Exit;
   }
@@ -750,6 +852,15 @@ EqosSnpTransmit (
   Eqos->TxNext = EQOS_TX_NEXT (DescIndex);
   Eqos->TxQueued++;
 
+  Eqos->Stats.TxTotalFrames++;
+  Eqos->Stats.TxTotalBytes += BufferSize;
+  EqosCountFrameType (
+    Frame,
+    &Eqos->Stats.TxUnicastFrames,
+    &Eqos->Stats.TxBroadcastFrames,
+    &Eqos->Stats.TxMulticastFrames
+    );
+
   Status = EFI_SUCCESS;
 
 Exit:
@@ -803,7 +914,6 @@ EqosSnpReceive (
 {
   EQOS_PRIVATE_DATA  *Eqos;
   EFI_STATUS         Status;
-  EFI_STATUS         MapStatus;
   UINT32             DescIndex;
   UINT8              *Frame;
   UINTN              FrameLength;
@@ -827,16 +937,34 @@ EqosSnpReceive (
     return EFI_ACCESS_DENIED;
   }
 
-  DescIndex   = Eqos->RxCurrent;
-  FrameLength = 0;
+  //
+  // Skip over any bad frames in one go rather than returning an error
+  // for each of them, so that the caller sees the next good frame.
+  //
+  while (TRUE) {
+    DescIndex   = Eqos->RxCurrent;
+    FrameLength = 0;
 
-  Status = EqosCheckRxDescriptor (Eqos, DescIndex, &FrameLength);
-  if (Status == EFI_NOT_READY) {
-    goto Exit;
-  } else if (EFI_ERROR (Status)) {
-    ASSERT (Eqos->RxBuffersMap[DescIndex] != NULL);
-    EqosDmaUnmapRxDescriptor (Eqos, DescIndex);
-    goto ReleaseDesc;
+    Status = EqosCheckRxDescriptor (Eqos, DescIndex, &FrameLength);
+    if (!EFI_ERROR (Status)) {
+      break;
+    }
+
+    if (Status == EFI_NOT_READY) {
+      //
+      // The ring has been drained, make sure the DMA gets
+      // back every descriptor we've consumed so far.
+      //
+      EqosDmaFlushRxDescriptors (Eqos);
+      goto Exit;
+    }
+
+    Eqos->Stats.RxTotalFrames++;
+    Eqos->Stats.RxDroppedFrames++;
+    Eqos->RxDescErrors++;
+
+    EqosDmaRefillRxDescriptor (Eqos, DescIndex);
+    Eqos->RxCurrent = EQOS_RX_NEXT (DescIndex);
   }
 
   if (*BufferSize < FrameLength) {
@@ -852,11 +980,13 @@ EqosSnpReceive (
     goto Exit;
   }
 
-  ASSERT (Eqos->RxBuffersMap[DescIndex] != NULL);
-  EqosDmaUnmapRxDescriptor (Eqos, DescIndex);
-
   Frame = EQOS_RX_BUFFER (Eqos, DescIndex);
 
+  //
+  // Drop any lines speculatively fetched while the DMA was writing.
+  //
+  InvalidateDataCacheRange (Frame, FrameLength);
+
   if (DestAddr != NULL) {
     CopyMem (&DestAddr->Addr[0], &Frame[0], NET_ETHER_ADDR_LEN);
   }
@@ -876,16 +1006,20 @@ EqosSnpReceive (
   CopyMem (Buffer, Frame, FrameLength);
   *BufferSize = FrameLength;
 
-  Status = EFI_SUCCESS;
+  Eqos->Stats.RxTotalFrames++;
+  Eqos->Stats.RxGoodFrames++;
+  Eqos->Stats.RxTotalBytes += FrameLength;
+  EqosCountFrameType (
+    Frame,
+    &Eqos->Stats.RxUnicastFrames,
+    &Eqos->Stats.RxBroadcastFrames,
+    &Eqos->Stats.RxMulticastFrames
+    );
 
-ReleaseDesc:
-  MapStatus = EqosDmaMapRxDescriptor (Eqos, DescIndex);
-  if (EFI_ERROR (MapStatus)) {
-    Status = MapStatus;
-    goto Exit;
-  }
+  EqosDmaRefillRxDescriptor (Eqos, DescIndex);
+  Eqos->RxCurrent = EQOS_RX_NEXT (DescIndex);
 
-  Eqos->RxCurrent = EQOS_RX_NEXT (Eqos->RxCurrent);
+  Status = EFI_SUCCESS;
 
 Exit:
   EfiReleaseLock (&Eqos->Lock);